@@ -0,0 +1,67 @@
+using System.Runtime.InteropServices;
+
+namespace RLCSWrapper.Core.Models
+{
+    /// <summary>
+    /// Statistics of the last planning call of a planner instance, laid out like the native RL_PlanStats.
+    /// Wall times are in milliseconds; counters cover the whole call.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct PlanStats
+    {
+        /// <summary>
+        /// Start/goal conversion, constraints and planner setup.
+        /// </summary>
+        public double ArgumentTimeMs;
+
+        /// <summary>
+        /// Start and goal verification.
+        /// </summary>
+        public double VerifyTimeMs;
+
+        /// <summary>
+        /// Path search.
+        /// </summary>
+        public double SolveTimeMs;
+
+        /// <summary>
+        /// Optimization, smoothing and output resampling.
+        /// </summary>
+        public double OptimizeTimeMs;
+
+        /// <summary>
+        /// Copying waypoints to the caller.
+        /// </summary>
+        public double CopyTimeMs;
+
+        /// <summary>
+        /// Whole call.
+        /// </summary>
+        public double TotalTimeMs;
+
+        /// <summary>
+        /// Vertices of the tree or roadmap.
+        /// </summary>
+        public long TreeSize;
+
+        /// <summary>
+        /// Configurations drawn by the sampler.
+        /// </summary>
+        public long Samples;
+
+        /// <summary>
+        /// Configurations checked for collision.
+        /// </summary>
+        public long CollisionChecks;
+
+        /// <summary>
+        /// Nearest neighbor and radius queries.
+        /// </summary>
+        public long NearestNeighborQueries;
+
+        /// <summary>
+        /// Shortcuts applied or waypoints removed by the optimizer.
+        /// </summary>
+        public long Shortcuts;
+    }
+}
@@ -0,0 +1,34 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace RLCSWrapper.Core
+{
+    /// <summary>
+    /// Owns a path result handle returned by PlanTrajectoryResult.
+    /// The native waypoint storage stays valid until the handle is disposed or finalized,
+    /// which calls ReleasePathResult exactly once.
+    /// </summary>
+    internal sealed class PathResultHandle : SafeHandle
+    {
+        /// <summary>
+        /// Initializes an invalid handle; the marshaller sets the native pointer.
+        /// </summary>
+        public PathResultHandle() : base(IntPtr.Zero, true)
+        {
+        }
+
+        /// <summary>
+        /// Gets whether the handle does not refer to a path result.
+        /// </summary>
+        public override bool IsInvalid => handle == IntPtr.Zero;
+
+        /// <summary>
+        /// Releases the native path result.
+        /// </summary>
+        protected override bool ReleaseHandle()
+        {
+            RLWrapper.ReleasePathResultNative(handle);
+            return true;
+        }
+    }
+}
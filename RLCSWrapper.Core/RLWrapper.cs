@@ -2,6 +2,7 @@ using System;
 using System.Runtime.InteropServices;
 using System.Runtime.Versioning;
 using RLCSWrapper.Core.Exceptions;
+using RLCSWrapper.Core.Models;
 
 // Win32 API for setting DLL search directory
 internal static class NativeMethods
@@ -48,6 +49,28 @@ namespace RLCSWrapper.Core
         private const int RL_ERROR_PLANNING_FAILED = -4;
         private const int RL_ERROR_NOT_INITIALIZED = -5;
         private const int RL_ERROR_EXCEPTION = -6;
+        private const int RL_ERROR_BUFFER_TOO_SMALL = -7;
+        private const int RL_ERROR_ABORTED = -8;
+        private const int RL_ERROR_GOAL_UNREACHABLE = -9;
+
+        // Values per path returned by EvaluatePathMetrics (RL_PATH_METRIC_COUNT)
+        private const int PathMetricCount = 4;
+
+        // Native callback signatures (RL_LogCallback, RL_WaypointCallback)
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        private delegate void LogCallback(int level, IntPtr message, IntPtr userData);
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        private delegate int WaypointCallback(IntPtr waypoints, int count, int dof, IntPtr userData);
+
+        // Log callback passed to SetLogSink, kept alive while the native logger may call it
+        private static LogCallback? _logCallback;
+
+        // Native call writing a planned path of up to maxWaypoints waypoints into buffer
+        private delegate int PlanIntoBuffer(double[] buffer, int maxWaypoints, out int waypointCount);
+
+        // Native call writing null-terminated text into buffer
+        private delegate int WriteToBuffer(byte[] buffer, int bufferSize, out int length);
 
         /// <summary>
         /// Gets the platform-specific library name.
@@ -245,12 +268,64 @@ namespace RLCSWrapper.Core
                 RL_ERROR_PLANNING_FAILED => "Trajectory planning failed",
                 RL_ERROR_NOT_INITIALIZED => "Planner not initialized",
                 RL_ERROR_EXCEPTION => "Exception occurred in native code",
+                RL_ERROR_BUFFER_TOO_SMALL => "Output buffer too small",
+                RL_ERROR_ABORTED => "Aborted by callback",
+                RL_ERROR_GOAL_UNREACHABLE => "Goal pose unreachable",
                 _ => $"Unknown error code: {errorCode}"
             };
 
             throw new PlanningException($"{operation} failed: {errorMessage}");
         }
 
+        /// <summary>
+        /// Runs a planning call writing at most maxWaypoints waypoints. A longer path is not planned
+        /// again, which would take another timeout and give a different path: RL_ERROR_BUFFER_TOO_SMALL
+        /// is reported with the full waypoint count, so the caller can pass a larger maxWaypoints.
+        /// </summary>
+        private static double[] PlanIntoArray(PlanIntoBuffer plan, int dof, int maxWaypoints, string operation, out int waypointCount)
+        {
+            double[] waypointsBuffer = new double[Math.Max(1, maxWaypoints) * dof];
+            int result = plan(waypointsBuffer, maxWaypoints, out waypointCount);
+
+            if (result == RL_ERROR_BUFFER_TOO_SMALL)
+            {
+                throw new PlanningException($"{operation} failed: path has {waypointCount} waypoints, maxWaypoints is {maxWaypoints}");
+            }
+            ThrowOnError(result, operation);
+
+            if (waypointCount <= 0)
+            {
+                return Array.Empty<double>();
+            }
+
+            double[] waypoints = new double[waypointCount * dof];
+            Array.Copy(waypointsBuffer, waypoints, waypointCount * dof);
+            return waypoints;
+        }
+
+        /// <summary>
+        /// Reads native text, retrying with a buffer of the reported length if it did not fit.
+        /// </summary>
+        private static string ReadNativeString(WriteToBuffer write, string operation)
+        {
+            byte[] buffer = new byte[4096];
+            int result;
+            int length;
+
+            while (true)
+            {
+                result = write(buffer, buffer.Length, out length);
+                if (result != RL_ERROR_BUFFER_TOO_SMALL || length < buffer.Length)
+                {
+                    break;
+                }
+                buffer = new byte[length + 1];
+            }
+
+            ThrowOnError(result, operation);
+            return System.Text.Encoding.UTF8.GetString(buffer, 0, length);
+        }
+
         // Native function declarations
 
         [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "CreatePlanner")]
@@ -289,6 +364,173 @@ namespace RLCSWrapper.Core
         [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "DestroyPlanner")]
         private static extern void DestroyPlannerNative(IntPtr planner);
 
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "SetCollisionEngine", CharSet = CharSet.Ansi)]
+        private static extern int SetCollisionEngineNative(IntPtr planner, [MarshalAs(UnmanagedType.LPStr)] string engine);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "GetCollisionEngines")]
+        private static extern int GetCollisionEnginesNative([Out] byte[] buffer, int bufferSize, out int length);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "PlanTrajectoryStreaming", CharSet = CharSet.Ansi)]
+        private static extern int PlanTrajectoryStreamingNative(
+            IntPtr planner,
+            [MarshalAs(UnmanagedType.LPArray)] double[] start, int startSize,
+            [MarshalAs(UnmanagedType.LPArray)] double[] goal, int goalSize,
+            int useZAxis, [MarshalAs(UnmanagedType.LPStr)] string plannerType,
+            double delta, double epsilon, int timeoutMs,
+            int chunkSize, WaypointCallback callback, IntPtr userData, out int waypointCount);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "PlanTrajectoryResult", CharSet = CharSet.Ansi)]
+        private static extern int PlanTrajectoryResultNative(
+            IntPtr planner,
+            [MarshalAs(UnmanagedType.LPArray)] double[] start, int startSize,
+            [MarshalAs(UnmanagedType.LPArray)] double[] goal, int goalSize,
+            int useZAxis, [MarshalAs(UnmanagedType.LPStr)] string plannerType,
+            double delta, double epsilon, int timeoutMs,
+            out PathResultHandle result);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "GetPathResult")]
+        private static extern int GetPathResultNative(PathResultHandle result, out IntPtr waypoints, out int stride, out int count);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "ReleasePathResult")]
+        internal static extern void ReleasePathResultNative(IntPtr result);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "SetRandomSeed")]
+        private static extern int SetRandomSeedNative(IntPtr planner, uint seed);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "GetLastPlanStats")]
+        private static extern int GetLastPlanStatsNative(IntPtr planner, out PlanStats stats);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "DumpMetrics", CharSet = CharSet.Ansi)]
+        private static extern int DumpMetricsNative([MarshalAs(UnmanagedType.LPStr)] string filePath);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "DumpMetricsToBuffer")]
+        private static extern int DumpMetricsToBufferNative([Out] byte[] buffer, int bufferSize, out int length);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "EnableTracing")]
+        private static extern void EnableTracingNative(int enabled);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "ExportTrace", CharSet = CharSet.Ansi)]
+        private static extern int ExportTraceNative([MarshalAs(UnmanagedType.LPStr)] string filePath);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "SetLogLevel")]
+        private static extern int SetLogLevelNative(int level);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "SetLogSink")]
+        private static extern int SetLogSinkNative(LogCallback? callback, IntPtr userData);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "SetLogFile", CharSet = CharSet.Ansi)]
+        private static extern int SetLogFileNative([MarshalAs(UnmanagedType.LPStr)] string filePath);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "FlushLog")]
+        private static extern void FlushLogNative();
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "SetLocalPlanner", CharSet = CharSet.Ansi)]
+        private static extern int SetLocalPlannerNative(IntPtr planner, [MarshalAs(UnmanagedType.LPStr)] string localPlannerType, double jacobianDamping);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "SetHierarchicalPlanning")]
+        private static extern int SetHierarchicalPlanningNative(IntPtr planner, int enable, double coarseFactor, double inflationMargin);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "SetPathOptimizer", CharSet = CharSet.Ansi)]
+        private static extern int SetPathOptimizerNative(IntPtr planner, [MarshalAs(UnmanagedType.LPStr)] string optimizerType, int optimizationTimeMs, int threadCount);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "SetPathCost", CharSet = CharSet.Ansi)]
+        private static extern int SetPathCostNative(IntPtr planner, [MarshalAs(UnmanagedType.LPStr)] string costType, [MarshalAs(UnmanagedType.LPArray)] double[]? maxTorque, int dof);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "SetPathOutput", CharSet = CharSet.Ansi)]
+        private static extern int SetPathOutputNative(IntPtr planner, [MarshalAs(UnmanagedType.LPStr)] string outputMode, double resolution);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "SetPathSmoothing")]
+        private static extern int SetPathSmoothingNative(IntPtr planner, double blendRadius, int samplesPerBlend);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "AddLockedJointConstraint")]
+        private static extern int AddLockedJointConstraintNative(IntPtr planner, int jointIndex, double value, int useStartValue);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "AddJointCouplingConstraint")]
+        private static extern int AddJointCouplingConstraintNative(IntPtr planner, int jointIndex, int referenceJointIndex, double ratio, double offset);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "SetToolOrientationConstraint")]
+        private static extern int SetToolOrientationConstraintNative(IntPtr planner, [MarshalAs(UnmanagedType.LPArray)] double[]? orientation, int axisOnly, double tolerance);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "ClearConstraints")]
+        private static extern int ClearConstraintsNative(IntPtr planner);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "BuildReachabilityMap", CharSet = CharSet.Ansi)]
+        private static extern int BuildReachabilityMapNative(IntPtr planner, [MarshalAs(UnmanagedType.LPStr)] string outputPath, double voxelSize, int samples);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "LoadReachabilityMap", CharSet = CharSet.Ansi)]
+        private static extern int LoadReachabilityMapNative(IntPtr planner, [MarshalAs(UnmanagedType.LPStr)] string mapPath);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "IsPoseReachable")]
+        private static extern int IsPoseReachableNative(IntPtr planner, [MarshalAs(UnmanagedType.LPArray)] double[] pose, int poseSize);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "GetPoseReachability")]
+        private static extern int GetPoseReachabilityNative(IntPtr planner, [MarshalAs(UnmanagedType.LPArray)] double[] pose, int poseSize, out int samples, out int orientations);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "PlanTrajectoryToPose", CharSet = CharSet.Ansi)]
+        private static extern int PlanTrajectoryToPoseNative(
+            IntPtr planner,
+            [MarshalAs(UnmanagedType.LPArray)] double[] start, int startSize,
+            [MarshalAs(UnmanagedType.LPArray)] double[] goalPose, int goalPoseSize,
+            [MarshalAs(UnmanagedType.LPStr)] string plannerType,
+            double delta, double epsilon, int timeoutMs,
+            [MarshalAs(UnmanagedType.LPArray)] double[] waypoints, int maxWaypoints, out int waypointCount);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "SetReplanningMode")]
+        private static extern int SetReplanningModeNative(IntPtr planner, int enable);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "SetReplanningMargin")]
+        private static extern int SetReplanningMarginNative(IntPtr planner, double margin);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "MoveSceneBody")]
+        private static extern int MoveSceneBodyNative(IntPtr planner, int modelIndex, int bodyIndex, [MarshalAs(UnmanagedType.LPArray)] double[] pose, int poseSize);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "AddRobotModel", CharSet = CharSet.Ansi)]
+        private static extern int AddRobotModelNative(IntPtr planner, [MarshalAs(UnmanagedType.LPStr)] string kinematicsXmlPath, int robotModelIndex);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "GetRobotCount")]
+        private static extern int GetRobotCountNative(IntPtr planner);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "GetRobotPlanner")]
+        private static extern IntPtr GetRobotPlannerNative(IntPtr planner, int robotIndex);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "PlanCoordinatedTrajectory", CharSet = CharSet.Ansi)]
+        private static extern int PlanCoordinatedTrajectoryNative(
+            IntPtr planner,
+            [MarshalAs(UnmanagedType.LPArray)] double[] starts, int startsSize,
+            [MarshalAs(UnmanagedType.LPArray)] double[] goals, int goalsSize,
+            [MarshalAs(UnmanagedType.LPStr)] string plannerType,
+            double delta, double epsilon, int timeoutMs,
+            [MarshalAs(UnmanagedType.LPArray)] double[] waypoints, int maxWaypoints, out int waypointCount);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "SetJointLimits")]
+        private static extern int SetJointLimitsNative(
+            IntPtr planner,
+            [MarshalAs(UnmanagedType.LPArray)] double[] maxVelocity,
+            [MarshalAs(UnmanagedType.LPArray)] double[] maxAcceleration,
+            [MarshalAs(UnmanagedType.LPArray)] double[]? maxJerk, int dof);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "TimeParameterizePath")]
+        private static extern int TimeParameterizePathNative(IntPtr planner, [MarshalAs(UnmanagedType.LPArray)] double[] waypoints, int waypointCount, [Out] double[] timestamps);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "SampleTrajectory")]
+        private static extern int SampleTrajectoryNative(
+            IntPtr planner,
+            [MarshalAs(UnmanagedType.LPArray)] double[] waypoints, int waypointCount,
+            double sampleTime,
+            [Out] double[] positions, [Out] double[] velocities, int maxSamples, out int sampleCount);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "EvaluatePathMetrics")]
+        private static extern int EvaluatePathMetricsNative(
+            IntPtr planner,
+            [MarshalAs(UnmanagedType.LPArray)] double[] waypoints, [MarshalAs(UnmanagedType.LPArray)] int[] waypointCounts, int pathCount,
+            int threadCount, [Out] double[] metrics);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "IsValidSegment")]
+        private static extern int IsValidSegmentNative(IntPtr planner, [MarshalAs(UnmanagedType.LPArray)] double[] from, [MarshalAs(UnmanagedType.LPArray)] double[] to, int configSize);
+
+        [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, EntryPoint = "ForwardKinematics")]
+        private static extern int ForwardKinematicsNative(IntPtr planner, [MarshalAs(UnmanagedType.LPArray)] double[] config, int configSize, [Out] double[] pose, int poseSize);
+
         // Managed wrapper methods
 
         /// <summary>
@@ -359,6 +601,7 @@ namespace RLCSWrapper.Core
 
         /// <summary>
         /// Plans a trajectory between start and goal configurations.
+        /// The path is taken from a result handle, so it is planned once whatever its length.
         /// </summary>
         internal static double[] PlanTrajectory(
             IntPtr planner,
@@ -366,52 +609,605 @@ namespace RLCSWrapper.Core
             bool useZAxis, string plannerType,
             double delta, double epsilon, TimeSpan timeout,
             out int waypointCount)
+        {
+            using (PathResultHandle result = PlanTrajectoryResult(planner, start, goal, useZAxis, plannerType, delta, epsilon, timeout))
+            {
+                return GetPathResult(result, out _, out waypointCount);
+            }
+        }
+
+        /// <summary>
+        /// Selects the collision engine of scenes loaded by later LoadScene and LoadPlanXml calls.
+        /// </summary>
+        internal static void SetCollisionEngine(IntPtr planner, string engine)
+        {
+            EnsureLibraryLoaded();
+            int result = SetCollisionEngineNative(planner, engine);
+            ThrowOnError(result, "SetCollisionEngine");
+        }
+
+        /// <summary>
+        /// Gets the compiled-in collision engines, default engine first.
+        /// </summary>
+        internal static string[] GetCollisionEngines()
+        {
+            EnsureLibraryLoaded();
+            string engines = ReadNativeString(GetCollisionEnginesNative, "GetCollisionEngines");
+            return engines.Split(',', StringSplitOptions.RemoveEmptyEntries);
+        }
+
+        /// <summary>
+        /// Plans a trajectory, passing the waypoints to onWaypoints in chunks of at most chunkSize waypoints.
+        /// onWaypoints receives the flattened chunk and the DOF and returns false to stop planning output.
+        /// Returns the number of waypoints passed to onWaypoints.
+        /// </summary>
+        internal static int PlanTrajectoryStreaming(
+            IntPtr planner,
+            double[] start, double[] goal,
+            bool useZAxis, string plannerType,
+            double delta, double epsilon, TimeSpan timeout,
+            int chunkSize, Func<double[], int, bool> onWaypoints)
         {
             EnsureLibraryLoaded();
 
-            // Determine DOF - use from arrays if provided, otherwise get from planner
-            int dof;
-            if (start != null && start.Length > 0)
+            // Exceptions must not unwind through native code; rethrown after the call
+            Exception? callbackException = null;
+            bool stopped = false;
+            WaypointCallback callback = (waypoints, count, dof, userData) =>
+            {
+                try
+                {
+                    double[] chunk = new double[count * dof];
+                    Marshal.Copy(waypoints, chunk, 0, chunk.Length);
+                    stopped = !onWaypoints(chunk, dof);
+                }
+                catch (Exception ex)
+                {
+                    callbackException = ex;
+                    stopped = true;
+                }
+                return stopped ? 1 : 0;
+            };
+
+            int result = PlanTrajectoryStreamingNative(
+                planner,
+                start, start?.Length ?? 0,
+                goal, goal?.Length ?? 0,
+                useZAxis ? 1 : 0, plannerType,
+                delta, epsilon, (int)timeout.TotalMilliseconds,
+                chunkSize, callback, IntPtr.Zero, out int waypointCount);
+            GC.KeepAlive(callback);
+
+            if (callbackException != null)
             {
-                dof = start.Length;
+                throw new PlanningException("PlanTrajectoryStreaming failed: waypoint callback threw", callbackException);
             }
-            else if (goal != null && goal.Length > 0)
+            if (!(result == RL_ERROR_ABORTED && stopped))
             {
-                dof = goal.Length;
+                ThrowOnError(result, "PlanTrajectoryStreaming");
             }
-            else
+            return waypointCount;
+        }
+
+        /// <summary>
+        /// Plans a trajectory and returns the path in a result handle, without a size limit.
+        /// Dispose the handle to release the path.
+        /// </summary>
+        internal static PathResultHandle PlanTrajectoryResult(
+            IntPtr planner,
+            double[] start, double[] goal,
+            bool useZAxis, string plannerType,
+            double delta, double epsilon, TimeSpan timeout)
+        {
+            EnsureLibraryLoaded();
+            int result = PlanTrajectoryResultNative(
+                planner,
+                start, start?.Length ?? 0,
+                goal, goal?.Length ?? 0,
+                useZAxis ? 1 : 0, plannerType,
+                delta, epsilon, (int)timeout.TotalMilliseconds,
+                out PathResultHandle handle);
+
+            if (result != RL_SUCCESS)
+            {
+                handle.Dispose();
+                ThrowOnError(result, "PlanTrajectoryResult");
+            }
+            return handle;
+        }
+
+        /// <summary>
+        /// Gets the waypoints of a result handle in place; the span is valid until the handle is disposed.
+        /// </summary>
+        internal static unsafe ReadOnlySpan<double> GetPathResultSpan(PathResultHandle result, out int stride, out int count)
+        {
+            EnsureLibraryLoaded();
+            int status = GetPathResultNative(result, out IntPtr waypoints, out stride, out count);
+            ThrowOnError(status, "GetPathResult");
+            return new ReadOnlySpan<double>(waypoints.ToPointer(), count * stride);
+        }
+
+        /// <summary>
+        /// Copies the waypoints of a result handle (flattened: count * stride values).
+        /// </summary>
+        internal static double[] GetPathResult(PathResultHandle result, out int stride, out int count)
+        {
+            return GetPathResultSpan(result, out stride, out count).ToArray();
+        }
+
+        /// <summary>
+        /// Seeds the random sources of the next planning call.
+        /// </summary>
+        internal static void SetRandomSeed(IntPtr planner, uint seed)
+        {
+            EnsureLibraryLoaded();
+            int result = SetRandomSeedNative(planner, seed);
+            ThrowOnError(result, "SetRandomSeed");
+        }
+
+        /// <summary>
+        /// Gets statistics of the last planning call.
+        /// </summary>
+        internal static PlanStats GetLastPlanStats(IntPtr planner)
+        {
+            EnsureLibraryLoaded();
+            int result = GetLastPlanStatsNative(planner, out PlanStats stats);
+            ThrowOnError(result, "GetLastPlanStats");
+            return stats;
+        }
+
+        /// <summary>
+        /// Writes process-wide metrics in Prometheus text format to a file.
+        /// </summary>
+        internal static void DumpMetrics(string filePath)
+        {
+            EnsureLibraryLoaded();
+            int result = DumpMetricsNative(filePath);
+            ThrowOnError(result, "DumpMetrics");
+        }
+
+        /// <summary>
+        /// Gets process-wide metrics in Prometheus text format.
+        /// </summary>
+        internal static string DumpMetricsToString()
+        {
+            EnsureLibraryLoaded();
+            return ReadNativeString(DumpMetricsToBufferNative, "DumpMetricsToBuffer");
+        }
+
+        /// <summary>
+        /// Enables or disables recording of trace events.
+        /// </summary>
+        internal static void EnableTracing(bool enabled)
+        {
+            EnsureLibraryLoaded();
+            EnableTracingNative(enabled ? 1 : 0);
+        }
+
+        /// <summary>
+        /// Writes the recorded trace events as Chrome trace JSON.
+        /// </summary>
+        internal static void ExportTrace(string filePath)
+        {
+            EnsureLibraryLoaded();
+            int result = ExportTraceNative(filePath);
+            ThrowOnError(result, "ExportTrace");
+        }
+
+        /// <summary>
+        /// Sets the minimum level of logged messages (0 debug, 1 info, 2 warning, 3 error, 4 off).
+        /// </summary>
+        internal static void SetLogLevel(int level)
+        {
+            EnsureLibraryLoaded();
+            int result = SetLogLevelNative(level);
+            ThrowOnError(result, "SetLogLevel");
+        }
+
+        /// <summary>
+        /// Sends log messages to sink (level, message) on the native log writer thread; null restores stderr.
+        /// </summary>
+        internal static void SetLogSink(Action<int, string>? sink)
+        {
+            EnsureLibraryLoaded();
+
+            LogCallback? callback = null;
+            if (sink != null)
             {
-                // Both are null - get DOF from planner
-                dof = GetDof(planner);
-                if (dof <= 0)
+                callback = (level, message, userData) =>
                 {
-                    throw new InvalidOperationException("Cannot determine DOF: arrays are null and GetDof failed");
-                }
+                    try
+                    {
+                        sink(level, Marshal.PtrToStringUTF8(message) ?? string.Empty);
+                    }
+                    catch (Exception)
+                    {
+                        // Exceptions must not unwind through the native log writer
+                    }
+                };
+            }
+
+            // Queued messages still go to the previous callback, which stays alive until they are written
+            FlushLogNative();
+            int result = SetLogSinkNative(callback, IntPtr.Zero);
+            ThrowOnError(result, "SetLogSink");
+            _logCallback = callback;
+        }
+
+        /// <summary>
+        /// Appends log messages to a file instead of stderr.
+        /// </summary>
+        internal static void SetLogFile(string filePath)
+        {
+            EnsureLibraryLoaded();
+            int result = SetLogFileNative(filePath);
+            ThrowOnError(result, "SetLogFile");
+        }
+
+        /// <summary>
+        /// Waits until all queued log messages are written.
+        /// </summary>
+        internal static void FlushLog()
+        {
+            EnsureLibraryLoaded();
+            FlushLogNative();
+        }
+
+        /// <summary>
+        /// Selects the local planner of the tree planners ("linear" or "jacobian").
+        /// </summary>
+        internal static void SetLocalPlanner(IntPtr planner, string localPlannerType, double jacobianDamping)
+        {
+            EnsureLibraryLoaded();
+            int result = SetLocalPlannerNative(planner, localPlannerType, jacobianDamping);
+            ThrowOnError(result, "SetLocalPlanner");
+        }
+
+        /// <summary>
+        /// Enables or disables hierarchical planning.
+        /// </summary>
+        internal static void SetHierarchicalPlanning(IntPtr planner, bool enable, double coarseFactor, double inflationMargin)
+        {
+            EnsureLibraryLoaded();
+            int result = SetHierarchicalPlanningNative(planner, enable ? 1 : 0, coarseFactor, inflationMargin);
+            ThrowOnError(result, "SetHierarchicalPlanning");
+        }
+
+        /// <summary>
+        /// Selects the path optimizer ("simple" or "advanced"), its time budget and threads.
+        /// </summary>
+        internal static void SetPathOptimizer(IntPtr planner, string optimizerType, int optimizationTimeMs, int threadCount)
+        {
+            EnsureLibraryLoaded();
+            int result = SetPathOptimizerNative(planner, optimizerType, optimizationTimeMs, threadCount);
+            ThrowOnError(result, "SetPathOptimizer");
+        }
+
+        /// <summary>
+        /// Selects the path cost ("length", "time" or "energy"); maxTorque null keeps the current torque limits.
+        /// </summary>
+        internal static void SetPathCost(IntPtr planner, string costType, double[]? maxTorque)
+        {
+            EnsureLibraryLoaded();
+            int result = SetPathCostNative(planner, costType, maxTorque, maxTorque?.Length ?? 0);
+            ThrowOnError(result, "SetPathCost");
+        }
+
+        /// <summary>
+        /// Selects the path output mode ("none", "joint", "cartesian" or "compress") and its resolution.
+        /// </summary>
+        internal static void SetPathOutput(IntPtr planner, string outputMode, double resolution)
+        {
+            EnsureLibraryLoaded();
+            int result = SetPathOutputNative(planner, outputMode, resolution);
+            ThrowOnError(result, "SetPathOutput");
+        }
+
+        /// <summary>
+        /// Enables (blendRadius > 0) or disables corner blending of optimized paths.
+        /// </summary>
+        internal static void SetPathSmoothing(IntPtr planner, double blendRadius, int samplesPerBlend)
+        {
+            EnsureLibraryLoaded();
+            int result = SetPathSmoothingNative(planner, blendRadius, samplesPerBlend);
+            ThrowOnError(result, "SetPathSmoothing");
+        }
+
+        /// <summary>
+        /// Locks a joint at value, or at its start configuration value if useStartValue is set.
+        /// </summary>
+        internal static void AddLockedJointConstraint(IntPtr planner, int jointIndex, double value, bool useStartValue)
+        {
+            EnsureLibraryLoaded();
+            int result = AddLockedJointConstraintNative(planner, jointIndex, value, useStartValue ? 1 : 0);
+            ThrowOnError(result, "AddLockedJointConstraint");
+        }
+
+        /// <summary>
+        /// Couples a joint linearly to a reference joint.
+        /// </summary>
+        internal static void AddJointCouplingConstraint(IntPtr planner, int jointIndex, int referenceJointIndex, double ratio, double offset)
+        {
+            EnsureLibraryLoaded();
+            int result = AddJointCouplingConstraintNative(planner, jointIndex, referenceJointIndex, ratio, offset);
+            ThrowOnError(result, "AddJointCouplingConstraint");
+        }
+
+        /// <summary>
+        /// Holds the tool orientation (qw, qx, qy, qz), or the start orientation if null.
+        /// </summary>
+        internal static void SetToolOrientationConstraint(IntPtr planner, double[]? orientation, bool axisOnly, double tolerance)
+        {
+            EnsureLibraryLoaded();
+            int result = SetToolOrientationConstraintNative(planner, orientation, axisOnly ? 1 : 0, tolerance);
+            ThrowOnError(result, "SetToolOrientationConstraint");
+        }
+
+        /// <summary>
+        /// Removes all planning constraints.
+        /// </summary>
+        internal static void ClearConstraints(IntPtr planner)
+        {
+            EnsureLibraryLoaded();
+            int result = ClearConstraintsNative(planner);
+            ThrowOnError(result, "ClearConstraints");
+        }
+
+        /// <summary>
+        /// Builds a reachability map, writes it to outputPath and keeps it loaded.
+        /// </summary>
+        internal static void BuildReachabilityMap(IntPtr planner, string outputPath, double voxelSize, int samples)
+        {
+            EnsureLibraryLoaded();
+            int result = BuildReachabilityMapNative(planner, outputPath, voxelSize, samples);
+            ThrowOnError(result, "BuildReachabilityMap");
+        }
+
+        /// <summary>
+        /// Loads a reachability map written by BuildReachabilityMap.
+        /// </summary>
+        internal static void LoadReachabilityMap(IntPtr planner, string mapPath)
+        {
+            EnsureLibraryLoaded();
+            int result = LoadReachabilityMapNative(planner, mapPath);
+            ThrowOnError(result, "LoadReachabilityMap");
+        }
+
+        /// <summary>
+        /// Checks if a tool pose was reached by a sample of the loaded reachability map.
+        /// </summary>
+        internal static bool IsPoseReachable(IntPtr planner, double[] pose)
+        {
+            EnsureLibraryLoaded();
+            int result = IsPoseReachableNative(planner, pose, pose.Length);
+            if (result < 0)
+            {
+                ThrowOnError(result, "IsPoseReachable");
             }
+            return result == 1;
+        }
 
-            // Estimate maximum waypoints (conservative estimate)
-            int maxWaypoints = 10000;
-            double[] waypointsBuffer = new double[maxWaypoints * dof];
+        /// <summary>
+        /// Gets the reachability score of a tool pose from the loaded reachability map.
+        /// </summary>
+        internal static void GetPoseReachability(IntPtr planner, double[] pose, out int samples, out int orientations)
+        {
+            EnsureLibraryLoaded();
+            int result = GetPoseReachabilityNative(planner, pose, pose.Length, out samples, out orientations);
+            ThrowOnError(result, "GetPoseReachability");
+        }
 
+        /// <summary>
+        /// Plans a trajectory to a tool pose, with the goal configuration found by inverse kinematics.
+        /// Throws PlanningException if the path has more than maxWaypoints waypoints.
+        /// </summary>
+        internal static double[] PlanTrajectoryToPose(
+            IntPtr planner,
+            double[] start, double[] goalPose,
+            string plannerType,
+            double delta, double epsilon, TimeSpan timeout,
+            out int waypointCount,
+            int maxWaypoints = 10000)
+        {
+            EnsureLibraryLoaded();
+            int dof = start.Length;
             int timeoutMs = (int)timeout.TotalMilliseconds;
-            int result = PlanTrajectoryNative(
-                planner, 
-                start!, start?.Length ?? 0, 
-                goal!, goal?.Length ?? 0,
-                useZAxis ? 1 : 0, plannerType,
-                delta, epsilon, timeoutMs,
-                waypointsBuffer, maxWaypoints, out waypointCount);
+            return PlanIntoArray(
+                (double[] buffer, int capacity, out int count) => PlanTrajectoryToPoseNative(
+                    planner,
+                    start, start.Length,
+                    goalPose, goalPose.Length,
+                    plannerType, delta, epsilon, timeoutMs,
+                    buffer, capacity, out count),
+                dof, maxWaypoints, "PlanTrajectoryToPose", out waypointCount);
+        }
 
-            ThrowOnError(result, "PlanTrajectory");
+        /// <summary>
+        /// Enables or disables replanning mode.
+        /// </summary>
+        internal static void SetReplanningMode(IntPtr planner, bool enable)
+        {
+            EnsureLibraryLoaded();
+            int result = SetReplanningModeNative(planner, enable ? 1 : 0);
+            ThrowOnError(result, "SetReplanningMode");
+        }
 
-            if (waypointCount <= 0)
+        /// <summary>
+        /// Sets the margin used to find the roadmap parts a moved scene body affects.
+        /// </summary>
+        internal static void SetReplanningMargin(IntPtr planner, double margin)
+        {
+            EnsureLibraryLoaded();
+            int result = SetReplanningMarginNative(planner, margin);
+            ThrowOnError(result, "SetReplanningMargin");
+        }
+
+        /// <summary>
+        /// Moves an obstacle body of the loaded scene (pose x, y, z or x, y, z, qw, qx, qy, qz).
+        /// </summary>
+        internal static void MoveSceneBody(IntPtr planner, int modelIndex, int bodyIndex, double[] pose)
+        {
+            EnsureLibraryLoaded();
+            int result = MoveSceneBodyNative(planner, modelIndex, bodyIndex, pose, pose.Length);
+            ThrowOnError(result, "MoveSceneBody");
+        }
+
+        /// <summary>
+        /// Adds another robot model of the loaded scene; returns its robot index.
+        /// </summary>
+        internal static int AddRobotModel(IntPtr planner, string kinematicsXmlPath, int robotModelIndex)
+        {
+            EnsureLibraryLoaded();
+            int result = AddRobotModelNative(planner, kinematicsXmlPath, robotModelIndex);
+            if (result < 0)
             {
-                return Array.Empty<double>();
+                ThrowOnError(result, "AddRobotModel");
             }
+            return result;
+        }
 
-            double[] waypoints = new double[waypointCount * dof];
-            Array.Copy(waypointsBuffer, waypoints, waypointCount * dof);
-            return waypoints;
+        /// <summary>
+        /// Gets the number of robots of the planner instance.
+        /// </summary>
+        internal static int GetRobotCount(IntPtr planner)
+        {
+            EnsureLibraryLoaded();
+            int result = GetRobotCountNative(planner);
+            if (result < 0)
+            {
+                ThrowOnError(result, "GetRobotCount");
+            }
+            return result;
+        }
+
+        /// <summary>
+        /// Gets the planning context of a single robot, owned by the planner instance.
+        /// </summary>
+        internal static IntPtr GetRobotPlanner(IntPtr planner, int robotIndex)
+        {
+            EnsureLibraryLoaded();
+            IntPtr robot = GetRobotPlannerNative(planner, robotIndex);
+            if (robot == IntPtr.Zero)
+            {
+                throw new PlanningException($"GetRobotPlanner failed: no robot {robotIndex}");
+            }
+            return robot;
+        }
+
+        /// <summary>
+        /// Plans coordinated trajectories of all robots; waypoints are composite configurations per time step.
+        /// Throws PlanningException if the path has more than maxWaypoints waypoints.
+        /// </summary>
+        internal static double[] PlanCoordinatedTrajectory(
+            IntPtr planner,
+            double[] starts, double[] goals,
+            string plannerType,
+            double delta, double epsilon, TimeSpan timeout,
+            out int waypointCount,
+            int maxWaypoints = 10000)
+        {
+            EnsureLibraryLoaded();
+            int timeoutMs = (int)timeout.TotalMilliseconds;
+            return PlanIntoArray(
+                (double[] buffer, int capacity, out int count) => PlanCoordinatedTrajectoryNative(
+                    planner,
+                    starts, starts.Length,
+                    goals, goals.Length,
+                    plannerType, delta, epsilon, timeoutMs,
+                    buffer, capacity, out count),
+                starts.Length, maxWaypoints, "PlanCoordinatedTrajectory", out waypointCount);
+        }
+
+        /// <summary>
+        /// Sets per-joint limits for time parameterization; maxJerk may be null.
+        /// </summary>
+        internal static void SetJointLimits(IntPtr planner, double[] maxVelocity, double[] maxAcceleration, double[]? maxJerk)
+        {
+            EnsureLibraryLoaded();
+            int result = SetJointLimitsNative(planner, maxVelocity, maxAcceleration, maxJerk, maxVelocity.Length);
+            ThrowOnError(result, "SetJointLimits");
+        }
+
+        /// <summary>
+        /// Time-optimal parameterization of a path; returns the time of each waypoint in seconds.
+        /// </summary>
+        internal static double[] TimeParameterizePath(IntPtr planner, double[] waypoints, int dof)
+        {
+            EnsureLibraryLoaded();
+            int waypointCount = waypoints.Length / dof;
+            double[] timestamps = new double[waypointCount];
+            int result = TimeParameterizePathNative(planner, waypoints, waypointCount, timestamps);
+            ThrowOnError(result, "TimeParameterizePath");
+            return timestamps;
+        }
+
+        /// <summary>
+        /// Time-optimal trajectory along a path sampled every sampleTime seconds.
+        /// Returns the positions (sampleCount * dof values).
+        /// </summary>
+        internal static double[] SampleTrajectory(IntPtr planner, double[] waypoints, int dof, double sampleTime, out double[] velocities, out int sampleCount)
+        {
+            EnsureLibraryLoaded();
+            int waypointCount = waypoints.Length / dof;
+            int maxSamples = 1024;
+
+            while (true)
+            {
+                double[] positions = new double[maxSamples * dof];
+                velocities = new double[maxSamples * dof];
+                int result = SampleTrajectoryNative(planner, waypoints, waypointCount, sampleTime, positions, velocities, maxSamples, out sampleCount);
+
+                // The trajectory is deterministic, so the reported count fits the next call
+                if (result == RL_ERROR_BUFFER_TOO_SMALL && sampleCount > maxSamples)
+                {
+                    maxSamples = sampleCount;
+                    continue;
+                }
+                ThrowOnError(result, "SampleTrajectory");
+
+                Array.Resize(ref positions, sampleCount * dof);
+                Array.Resize(ref velocities, sampleCount * dof);
+                return positions;
+            }
+        }
+
+        /// <summary>
+        /// Computes quality metrics of concatenated paths; returns 4 values per path
+        /// (length, minimum clearance, joint reversals, duration).
+        /// </summary>
+        internal static double[] EvaluatePathMetrics(IntPtr planner, double[] waypoints, int[] waypointCounts, int threadCount)
+        {
+            EnsureLibraryLoaded();
+            double[] metrics = new double[waypointCounts.Length * PathMetricCount];
+            int result = EvaluatePathMetricsNative(planner, waypoints, waypointCounts, waypointCounts.Length, threadCount, metrics);
+            ThrowOnError(result, "EvaluatePathMetrics");
+            return metrics;
+        }
+
+        /// <summary>
+        /// Checks the straight joint-space segment between two configurations.
+        /// </summary>
+        internal static bool IsValidSegment(IntPtr planner, double[] from, double[] to)
+        {
+            EnsureLibraryLoaded();
+            int result = IsValidSegmentNative(planner, from, to, from.Length);
+            if (result < 0)
+            {
+                ThrowOnError(result, "IsValidSegment");
+            }
+            return result == 1;
+        }
+
+        /// <summary>
+        /// Computes the tool pose of a configuration (poseSize 3 for position, 7 with orientation).
+        /// </summary>
+        internal static double[] ForwardKinematics(IntPtr planner, double[] config, int poseSize = 7)
+        {
+            EnsureLibraryLoaded();
+            double[] pose = new double[poseSize];
+            int result = ForwardKinematicsNative(planner, config, config.Length, pose, poseSize);
+            ThrowOnError(result, "ForwardKinematics");
+            return pose;
         }
 
         /// <summary>
@@ -3,6 +3,7 @@ using System.Collections.Generic;
 using System.IO;
 using System.Linq;
 using RLCSWrapper.Core;
+using RLCSWrapper.Core.Exceptions;
 using RLCSWrapper.Core.Models;
 
 namespace RLCSWrapper.Test
@@ -16,6 +17,7 @@ namespace RLCSWrapper.Test
     /// - LoadPlanXml functionality
     /// - SetStartConfiguration and SetGoalConfiguration
     /// - Multiple trajectory planning with persistent scene
+    /// - Unlimited path length, path result handles, planning constraints, path output modes and time parameterization
     /// </summary>
     class Program
     {
@@ -29,7 +31,7 @@ namespace RLCSWrapper.Test
             Console.WriteLine("  --plan <path>           Path to plan XML file (contains kinematics/scene references)");
             Console.WriteLine("  --kinematics <path>     Path to kinematics XML file (required if not using --plan)");
             Console.WriteLine("  --scene <path>          Path to scene XML file (required if not using --plan)");
-            Console.WriteLine("  --test <number>         Run specific test (1-6), or \"all\" for all tests (default: all)");
+            Console.WriteLine("  --test <number>         Run specific test (1-11), or \"all\" for all tests (default: all)");
             Console.WriteLine("  --help                  Show this help message\n");
             Console.WriteLine("Available Tests:");
             Console.WriteLine("  1  - 2D Planning (Z-axis fixed)");
@@ -37,7 +39,11 @@ namespace RLCSWrapper.Test
             Console.WriteLine("  3  - Different Planner Algorithms");
             Console.WriteLine("  4  - Multiple Trajectories (Scene Reuse)");
             Console.WriteLine("  5  - Low-Level API - SetStart/SetGoal");
-            Console.WriteLine("  6  - LoadPlanXml (requires --plan option)\n");
+            Console.WriteLine("  6  - LoadPlanXml (requires --plan option)");
+            Console.WriteLine("  7  - Low-Level API - Retry on RL_ERROR_BUFFER_TOO_SMALL");
+            Console.WriteLine("  8  - Low-Level API - Path Result Handle Lifetime");
+            Console.WriteLine("  9  - Low-Level API - Locked Joint Constraint");
+            Console.WriteLine("  10 - Low-Level API - Path Output Modes\n");
             Console.WriteLine("Examples:");
             Console.WriteLine("  # Run Test 6 with plan XML (plan XML contains kinematics/scene paths):");
             Console.WriteLine("  RLCSWrapper.Test.exe --plan test_plan.xml --test 6");
@@ -125,15 +131,17 @@ namespace RLCSWrapper.Test
             string? kinematicsPath = parsedArgs.ContainsKey("kinematics") ? parsedArgs["kinematics"] : null;
             string? scenePath = parsedArgs.ContainsKey("scene") ? parsedArgs["scene"] : null;
 
-            // Determine which tests need kinematics/scene (tests 1-5)
+            // Determine which tests need kinematics/scene (all but test 6)
             bool needsKinematicsScene = ShouldRunTest(1, parsedArgs) || ShouldRunTest(2, parsedArgs) ||
                                        ShouldRunTest(3, parsedArgs) || ShouldRunTest(4, parsedArgs) ||
-                                       ShouldRunTest(5, parsedArgs);
+                                       ShouldRunTest(5, parsedArgs) || ShouldRunTest(7, parsedArgs) ||
+                                       ShouldRunTest(8, parsedArgs) || ShouldRunTest(9, parsedArgs) ||
+                                       ShouldRunTest(10, parsedArgs);
 
             // Validate required arguments
             if (planXmlPath == null)
             {
-                // If not using plan XML, kinematics and scene are required for tests 1-5
+                // If not using plan XML, kinematics and scene are required for all but test 6
                 if (needsKinematicsScene)
                 {
                     if (kinematicsPath == null)
@@ -337,6 +345,33 @@ namespace RLCSWrapper.Test
                     }
                 }
 
+                // Tests 7-11: Low-level API features of the native wrapper
+                var lowLevelTests = new (int Number, string Title, Action<string, string> Run)[]
+                {
+                    (7, "Low-Level API - Path Planned Once Without Size Limit", TestUnlimitedPath),
+                    (8, "Low-Level API - Path Result Handle Lifetime", TestPathResultHandle),
+                    (9, "Low-Level API - Locked Joint Constraint", TestLockedJointConstraint),
+                    (10, "Low-Level API - Path Output Modes", TestPathOutputModes),
+                    (11, "Low-Level API - Time Parameterization", TestTimeParameterization)
+                };
+                foreach (var test in lowLevelTests)
+                {
+                    if (!ShouldRunTest(test.Number, parsedArgs))
+                    {
+                        continue;
+                    }
+
+                    Console.WriteLine($"\n=== Test {test.Number}: {test.Title} ===");
+                    if (kinematicsPath == null || scenePath == null)
+                    {
+                        Console.WriteLine($"  Error: Kinematics and scene paths are required for Test {test.Number}");
+                    }
+                    else
+                    {
+                        test.Run(kinematicsPath, scenePath);
+                    }
+                }
+
                 Console.WriteLine("\n✓ All requested tests completed successfully!");
             }
             catch (Exception ex)
@@ -809,5 +844,386 @@ namespace RLCSWrapper.Test
                 }
             }
         }
+
+        /// <summary>
+        /// Creates a planner instance with kinematics and scene loaded, for the low-level API tests.
+        /// </summary>
+        static IntPtr CreateLoadedPlanner(string kinematicsPath, string scenePath, out int dof)
+        {
+            IntPtr planner = RLWrapper.CreatePlanner();
+            RLWrapper.LoadKinematics(planner, Path.GetFullPath(kinematicsPath));
+            RLWrapper.LoadScene(planner, Path.GetFullPath(scenePath), robotModelIndex: 0);
+            dof = RLWrapper.GetDof(planner);
+            return planner;
+        }
+
+        /// <summary>
+        /// Copies the waypoint at index out of a flattened path.
+        /// </summary>
+        static double[] GetWaypoint(double[] waypoints, int index, int dof)
+        {
+            double[] waypoint = new double[dof];
+            Array.Copy(waypoints, index * dof, waypoint, 0, dof);
+            return waypoint;
+        }
+
+        static bool AreClose(double[] a, double[] b, double tolerance)
+        {
+            return a.Length == b.Length && a.Zip(b, (x, y) => Math.Abs(x - y)).All(d => d <= tolerance);
+        }
+
+        /// <summary>
+        /// Tests that PlanTrajectory returns the whole path of a single plan, without a size limit.
+        /// </summary>
+        static void TestUnlimitedPath(string kinematicsPath, string scenePath)
+        {
+            IntPtr planner = IntPtr.Zero;
+
+            try
+            {
+                planner = CreateLoadedPlanner(kinematicsPath, scenePath, out int dof);
+                double[] start = new double[dof];
+                double[] goal = Enumerable.Repeat(0.5, dof).ToArray();
+
+                Console.WriteLine("  Planning with PlanTrajectory...");
+                RLWrapper.SetRandomSeed(planner, 7);
+                double[] waypoints = RLWrapper.PlanTrajectory(
+                    planner, start, goal, useZAxis: true, plannerType: "rrtConCon",
+                    delta: 0.1, epsilon: 0.001, timeout: TimeSpan.FromSeconds(10),
+                    waypointCount: out int waypointCount);
+
+                if (waypointCount < 2 || waypoints.Length != waypointCount * dof)
+                {
+                    Console.WriteLine($"    ✗ Expected a full path, got {waypointCount} waypoints ({waypoints.Length} values)");
+                    return;
+                }
+                if (!AreClose(GetWaypoint(waypoints, 0, dof), start, 1e-6) || !AreClose(GetWaypoint(waypoints, waypointCount - 1, dof), goal, 1e-6))
+                {
+                    Console.WriteLine("    ✗ Path does not run from start to goal");
+                    return;
+                }
+                Console.WriteLine($"    ✓ Returned all {waypointCount} waypoints from start to goal");
+
+                // With the same seed a result handle holds the same path, so nothing was planned twice
+                Console.WriteLine("  Planning again with the same seed through a result handle...");
+                RLWrapper.SetRandomSeed(planner, 7);
+                using (PathResultHandle result = RLWrapper.PlanTrajectoryResult(
+                    planner, start, goal, useZAxis: true, plannerType: "rrtConCon",
+                    delta: 0.1, epsilon: 0.001, timeout: TimeSpan.FromSeconds(10)))
+                {
+                    double[] expected = RLWrapper.GetPathResult(result, out _, out int expectedCount);
+                    if (expectedCount != waypointCount || !AreClose(expected, waypoints, 1e-9))
+                    {
+                        Console.WriteLine($"    ✗ Paths differ: {waypointCount} and {expectedCount} waypoints");
+                        return;
+                    }
+                }
+                Console.WriteLine("    ✓ Same path as the result handle");
+            }
+            catch (Exception ex)
+            {
+                Console.WriteLine($"  ✗ Error in unlimited path test: {ex.Message}");
+            }
+            finally
+            {
+                if (planner != IntPtr.Zero)
+                {
+                    RLWrapper.DestroyPlanner(planner);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Tests reading a path result handle in place and releasing it exactly once.
+        /// </summary>
+        static void TestPathResultHandle(string kinematicsPath, string scenePath)
+        {
+            IntPtr planner = IntPtr.Zero;
+
+            try
+            {
+                planner = CreateLoadedPlanner(kinematicsPath, scenePath, out int dof);
+                double[] start = new double[dof];
+                double[] goal = Enumerable.Repeat(0.5, dof).ToArray();
+
+                PathResultHandle result = RLWrapper.PlanTrajectoryResult(
+                    planner, start, goal, useZAxis: true, plannerType: "rrtConCon",
+                    delta: 0.1, epsilon: 0.001, timeout: TimeSpan.FromSeconds(10));
+
+                using (result)
+                {
+                    ReadOnlySpan<double> span = RLWrapper.GetPathResultSpan(result, out int stride, out int count);
+                    double[] copy = RLWrapper.GetPathResult(result, out _, out _);
+
+                    if (stride != dof || count < 2 || span.Length != count * stride || !span.SequenceEqual(copy))
+                    {
+                        Console.WriteLine($"    ✗ Unexpected result layout: stride {stride}, count {count}, {span.Length} values");
+                        return;
+                    }
+                    if (!AreClose(GetWaypoint(copy, 0, dof), start, 1e-6) || !AreClose(GetWaypoint(copy, count - 1, dof), goal, 1e-6))
+                    {
+                        Console.WriteLine("    ✗ Result path does not run from start to goal");
+                        return;
+                    }
+                    Console.WriteLine($"    ✓ Read {count} waypoints in place (stride {stride})");
+                }
+
+                if (!result.IsClosed)
+                {
+                    Console.WriteLine("    ✗ Handle still open after Dispose");
+                    return;
+                }
+
+                // A second Dispose must not release the native result again
+                result.Dispose();
+
+                try
+                {
+                    RLWrapper.GetPathResult(result, out _, out _);
+                    Console.WriteLine("    ✗ Reading a released handle did not throw");
+                    return;
+                }
+                catch (ObjectDisposedException)
+                {
+                    Console.WriteLine("    ✓ Released handle is closed and rejected on use");
+                }
+            }
+            catch (Exception ex)
+            {
+                Console.WriteLine($"  ✗ Error in path result handle test: {ex.Message}");
+            }
+            finally
+            {
+                if (planner != IntPtr.Zero)
+                {
+                    RLWrapper.DestroyPlanner(planner);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Tests that a locked joint constraint holds on every planned waypoint.
+        /// </summary>
+        static void TestLockedJointConstraint(string kinematicsPath, string scenePath)
+        {
+            IntPtr planner = IntPtr.Zero;
+
+            try
+            {
+                planner = CreateLoadedPlanner(kinematicsPath, scenePath, out int dof);
+                if (dof < 2)
+                {
+                    Console.WriteLine("  Skipped: Robot DOF < 2");
+                    return;
+                }
+
+                int locked = dof - 1;
+                double[] start = new double[dof];
+                double[] goal = Enumerable.Repeat(0.5, dof).ToArray();
+                goal[locked] = start[locked];
+
+                // useZAxis keeps the last joint free, so only the constraint holds it
+                RLWrapper.AddLockedJointConstraint(planner, locked, 0.0, useStartValue: true);
+                double[] waypoints = RLWrapper.PlanTrajectory(
+                    planner, start, goal, useZAxis: true, plannerType: "rrtConCon",
+                    delta: 0.1, epsilon: 0.001, timeout: TimeSpan.FromSeconds(10),
+                    waypointCount: out int waypointCount);
+                RLWrapper.ClearConstraints(planner);
+
+                double maxDeviation = 0;
+                for (int i = 0; i < waypointCount; ++i)
+                {
+                    maxDeviation = Math.Max(maxDeviation, Math.Abs(waypoints[i * dof + locked] - start[locked]));
+                }
+
+                if (waypointCount < 2 || maxDeviation > 1e-6)
+                {
+                    Console.WriteLine($"    ✗ Joint {locked} moved by up to {maxDeviation} over {waypointCount} waypoints");
+                    return;
+                }
+                Console.WriteLine($"    ✓ Joint {locked} stayed at {start[locked]} on all {waypointCount} waypoints");
+            }
+            catch (Exception ex)
+            {
+                Console.WriteLine($"  ✗ Error in locked joint constraint test: {ex.Message}");
+            }
+            finally
+            {
+                if (planner != IntPtr.Zero)
+                {
+                    RLWrapper.DestroyPlanner(planner);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Tests the path output modes against the same seeded plan.
+        /// </summary>
+        static void TestPathOutputModes(string kinematicsPath, string scenePath)
+        {
+            IntPtr planner = IntPtr.Zero;
+
+            try
+            {
+                planner = CreateLoadedPlanner(kinematicsPath, scenePath, out int dof);
+                double[] start = new double[dof];
+                double[] goal = Enumerable.Repeat(0.5, dof).ToArray();
+                const double resolution = 0.05;
+
+                double[] Plan(string mode, out int count)
+                {
+                    RLWrapper.SetPathOutput(planner, mode, resolution);
+                    RLWrapper.SetRandomSeed(planner, 42);
+                    return RLWrapper.PlanTrajectory(
+                        planner, start, goal, useZAxis: true, plannerType: "rrtConCon",
+                        delta: 0.1, epsilon: 0.001, timeout: TimeSpan.FromSeconds(10),
+                        waypointCount: out count);
+                }
+
+                Plan("none", out int noneCount);
+                double[] joint = Plan("joint", out int jointCount);
+                Plan("cartesian", out int cartesianCount);
+                Plan("compress", out int compressCount);
+                RLWrapper.SetPathOutput(planner, "none", 0.0);
+                Console.WriteLine($"    Waypoints: none {noneCount}, joint {jointCount}, cartesian {cartesianCount}, compress {compressCount}");
+
+                double maxStep = 0;
+                for (int i = 1; i < jointCount; ++i)
+                {
+                    double step = Math.Sqrt(Enumerable.Range(0, dof).Sum(j => Math.Pow(joint[i * dof + j] - joint[(i - 1) * dof + j], 2)));
+                    maxStep = Math.Max(maxStep, step);
+                }
+
+                bool passed = true;
+                if (maxStep > resolution + 1e-9)
+                {
+                    Console.WriteLine($"    ✗ \"joint\" output has a step of {maxStep}, more than {resolution}");
+                    passed = false;
+                }
+                if (jointCount < noneCount || cartesianCount < noneCount)
+                {
+                    Console.WriteLine("    ✗ Resampled output has fewer waypoints than the planned path");
+                    passed = false;
+                }
+                if (compressCount > noneCount || compressCount < 2)
+                {
+                    Console.WriteLine("    ✗ \"compress\" output is not a reduced path");
+                    passed = false;
+                }
+                if (passed)
+                {
+                    Console.WriteLine($"    ✓ Output modes resample and compress the same plan (max joint step {maxStep:F4})");
+                }
+            }
+            catch (Exception ex)
+            {
+                Console.WriteLine($"  ✗ Error in path output test: {ex.Message}");
+            }
+            finally
+            {
+                if (planner != IntPtr.Zero)
+                {
+                    RLWrapper.DestroyPlanner(planner);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Tests time parameterization and sampling of a planned path under joint limits,
+        /// and that unreachable jerk limits are reported as a failure.
+        /// </summary>
+        static void TestTimeParameterization(string kinematicsPath, string scenePath)
+        {
+            IntPtr planner = IntPtr.Zero;
+
+            try
+            {
+                planner = CreateLoadedPlanner(kinematicsPath, scenePath, out int dof);
+                double[] start = new double[dof];
+                double[] goal = Enumerable.Repeat(0.5, dof).ToArray();
+                double[] maxVelocity = Enumerable.Repeat(1.0, dof).ToArray();
+                double[] maxAcceleration = Enumerable.Repeat(2.0, dof).ToArray();
+
+                RLWrapper.SetRandomSeed(planner, 11);
+                double[] waypoints = RLWrapper.PlanTrajectory(
+                    planner, start, goal, useZAxis: true, plannerType: "rrtConCon",
+                    delta: 0.1, epsilon: 0.001, timeout: TimeSpan.FromSeconds(10),
+                    waypointCount: out int waypointCount);
+                RLWrapper.SetJointLimits(planner, maxVelocity, maxAcceleration, null);
+
+                Console.WriteLine("  Timing the planned path...");
+                double[] timestamps = RLWrapper.TimeParameterizePath(planner, waypoints, dof);
+                bool passed = true;
+                if (timestamps.Length != waypointCount || timestamps[0] != 0 || timestamps[^1] <= 0)
+                {
+                    Console.WriteLine($"    ✗ Expected {waypointCount} timestamps from 0 to a positive duration");
+                    passed = false;
+                }
+                for (int i = 1; i < timestamps.Length; ++i)
+                {
+                    if (timestamps[i] < timestamps[i - 1])
+                    {
+                        Console.WriteLine($"    ✗ Timestamp {i} goes back in time");
+                        passed = false;
+                        break;
+                    }
+                }
+
+                Console.WriteLine("  Sampling the trajectory every 10 ms...");
+                double sampleTime = 0.01;
+                double[] positions = RLWrapper.SampleTrajectory(planner, waypoints, dof, sampleTime, out double[] velocities, out int sampleCount);
+                int expectedCount = (int)Math.Ceiling(timestamps[^1] / sampleTime) + 1;
+                if (Math.Abs(sampleCount - expectedCount) > 1 || positions.Length != sampleCount * dof)
+                {
+                    Console.WriteLine($"    ✗ Got {sampleCount} samples, expected about {expectedCount}");
+                    passed = false;
+                }
+                else if (!AreClose(GetWaypoint(positions, 0, dof), start, 1e-6) || !AreClose(GetWaypoint(positions, sampleCount - 1, dof), goal, 1e-6))
+                {
+                    Console.WriteLine("    ✗ Trajectory does not run from start to goal");
+                    passed = false;
+                }
+                else if (!AreClose(GetWaypoint(velocities, 0, dof), new double[dof], 1e-6) || !AreClose(GetWaypoint(velocities, sampleCount - 1, dof), new double[dof], 1e-6))
+                {
+                    Console.WriteLine("    ✗ Trajectory does not start and end at rest");
+                    passed = false;
+                }
+                else if (velocities.Select((v, i) => Math.Abs(v) - maxVelocity[i % dof]).Max() > 1e-3)
+                {
+                    Console.WriteLine("    ✗ Trajectory exceeds the velocity limits");
+                    passed = false;
+                }
+
+                // Jerk reductions give up after a fixed number of iterations, so a tiny jerk limit fails
+                Console.WriteLine("  Timing the path with unreachable jerk limits...");
+                RLWrapper.SetJointLimits(planner, maxVelocity, maxAcceleration, Enumerable.Repeat(1e-6, dof).ToArray());
+                try
+                {
+                    RLWrapper.TimeParameterizePath(planner, waypoints, dof);
+                    Console.WriteLine("    ✗ Unreachable jerk limits were reported as success");
+                    passed = false;
+                }
+                catch (PlanningException)
+                {
+                    // Expected: the limits cannot be met
+                }
+
+                if (passed)
+                {
+                    Console.WriteLine($"    ✓ {sampleCount} samples over {timestamps[^1]:F3} s within the limits, unreachable jerk limits rejected");
+                }
+            }
+            catch (Exception ex)
+            {
+                Console.WriteLine($"  ✗ Error in time parameterization test: {ex.Message}");
+            }
+            finally
+            {
+                if (planner != IntPtr.Zero)
+                {
+                    RLWrapper.DestroyPlanner(planner);
+                }
+            }
+        }
     }
 }
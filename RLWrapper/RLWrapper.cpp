@@ -6,17 +6,32 @@
 #define RLWRAPPER_EXPORTS
 #include "RLWrapper.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <climits>
 #include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <functional>
+#include <fstream>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include <boost/any.hpp>
+
 #include <rl/kin/Kinematics.h>
 #include <rl/math/Vector.h>
 #include <rl/mdl/Dynamic.h>
@@ -46,6 +61,9 @@
 #include <rl/xml/Path.h>
 #include <rl/xml/Stylesheet.h>
 #include <rl/math/Constants.h>
+#include <rl/math/Quaternion.h>
+#include <rl/math/Rotation.h>
+#include <rl/math/Transform.h>
 
 #ifdef RL_SG_BULLET
 #include <rl/sg/bullet/Scene.h>
@@ -63,491 +81,6264 @@
 #include <rl/sg/solid/Scene.h>
 #endif
 
-// Internal planner state structure
-struct PlannerState
+// Voxelized map of collision-free tool positions for the loaded robot and static scene
+// Each voxel counts the collision-free samples per approach direction bin (tool z-axis)
+struct ReachabilityMap
 {
-    std::shared_ptr<rl::sg::Scene> scene;
-    std::shared_ptr<rl::kin::Kinematics> kinematics;
-    std::shared_ptr<rl::mdl::Model> mdl;  // Keep model alive if it's a Dynamic model
-    std::shared_ptr<rl::plan::SimpleModel> model;
-    rl::sg::Model* robotModel;
-    bool initialized;
+    static const int POLAR_BINS = 8;
+    static const int AZIMUTH_BINS = 8;
+    static const int ORIENTATION_BINS = POLAR_BINS * AZIMUTH_BINS;
     
-    // Persistent planner components
-    std::shared_ptr<rl::plan::Planner> planner;
-    std::shared_ptr<rl::plan::Sampler> sampler;
-    std::shared_ptr<rl::plan::Verifier> verifier;
-    std::shared_ptr<rl::plan::NearestNeighbors> nearestNeighbors;
-    std::shared_ptr<rl::plan::SimpleOptimizer> optimizer;
+    int dof;
+    double voxelSize;
+    rl::math::Vector3 origin;
+    int dims[3];
+    std::vector<std::uint16_t> counts;  // ORIENTATION_BINS per voxel, saturating
     
-    // Stored start/goal configurations
-    std::shared_ptr<rl::math::Vector> start;
-    std::shared_ptr<rl::math::Vector> goal;
+    ReachabilityMap() : dof(0), voxelSize(0.05), origin(rl::math::Vector3::Zero()) { dims[0] = dims[1] = dims[2] = 0; }
     
-    // Planner type and parameters
-    std::string plannerType;
-    double delta;
-    double epsilon;
-    int timeoutMs;
+    // Returns voxel index for position, or -1 if outside the mapped volume
+    long voxelIndex(const rl::math::Vector3& position) const
+    {
+        long index = 0;
+        for (int i = 2; i >= 0; --i)
+        {
+            long cell = static_cast<long>(std::floor((position(i) - origin(i)) / voxelSize));
+            if (cell < 0 || cell >= dims[i])
+            {
+                return -1;
+            }
+            index = index * dims[i] + cell;
+        }
+        return index;
+    }
+    
+    static int orientationBin(const rl::math::Vector3& approach)
+    {
+        double polar = std::acos(std::max(-1.0, std::min(1.0, static_cast<double>(approach.z()))));
+        double azimuth = std::atan2(approach.y(), approach.x()) + rl::math::constants::pi;
+        int polarBin = std::min(POLAR_BINS - 1, static_cast<int>(polar / rl::math::constants::pi * POLAR_BINS));
+        int azimuthBin = std::min(AZIMUTH_BINS - 1, static_cast<int>(azimuth / (2 * rl::math::constants::pi) * AZIMUTH_BINS));
+        return polarBin * AZIMUTH_BINS + azimuthBin;
+    }
+    
+    void add(long voxel, int bin)
+    {
+        std::uint16_t& count = counts[voxel * ORIENTATION_BINS + bin];
+        if (count < std::numeric_limits<std::uint16_t>::max())
+        {
+            ++count;
+        }
+    }
     
-    PlannerState() : robotModel(nullptr), initialized(false), delta(0.1), epsilon(0.001), timeoutMs(30000) {}
+    // Samples that reached the pose (all approach directions for position-only poses) and
+    // approach direction bins reached in its voxel; both 0 outside the mapped volume
+    void lookup(const rl::math::Transform& pose, bool hasOrientation, int& samples, int& orientations) const
+    {
+        samples = 0;
+        orientations = 0;
+        
+        long voxel = voxelIndex(pose.translation());
+        if (voxel < 0)
+        {
+            return;
+        }
+        
+        const std::uint16_t* bins = &counts[voxel * ORIENTATION_BINS];
+        for (int i = 0; i < ORIENTATION_BINS; ++i)
+        {
+            samples += hasOrientation ? 0 : bins[i];
+            orientations += bins[i] > 0 ? 1 : 0;
+        }
+        
+        if (hasOrientation)
+        {
+            samples = bins[orientationBin(pose.linear().col(2))];
+        }
+    }
 };
 
-// Helper function to create scene based on available engines
-static std::shared_ptr<rl::sg::Scene> createScene()
+// Joint held at a fixed value, or at its start value, during planning
+struct JointLock
 {
-#ifdef RL_SG_FCL
-    return std::make_shared<rl::sg::fcl::Scene>();
-#elif defined(RL_SG_ODE)
-    return std::make_shared<rl::sg::ode::Scene>();
-#elif defined(RL_SG_PQP)
-    return std::make_shared<rl::sg::pqp::Scene>();
-#elif defined(RL_SG_BULLET)
-    return std::make_shared<rl::sg::bullet::Scene>();
-#elif defined(RL_SG_SOLID)
-    return std::make_shared<rl::sg::solid::Scene>();
-#else
-    throw std::runtime_error("No collision detection engine available");
-#endif
-}
+    int joint;
+    double value;
+    bool useStartValue;
+};
 
-// Helper function to constrain Z-axis for 2D planning
-static void constrainZAxis(rl::math::Vector& goal, const rl::math::Vector& start, int zAxisIndex)
+// Linear joint coupling q(joint) = ratio * q(reference) + offset
+struct JointCoupling
 {
-    if (zAxisIndex >= 0 && zAxisIndex < static_cast<int>(goal.size()))
-    {
-        goal(zAxisIndex) = start(zAxisIndex);
-    }
-}
+    int joint;
+    int reference;
+    double ratio;
+    double offset;
+};
 
-extern "C" {
+// Tool orientation held at target, or at start orientation, optionally only the tool z-axis
+struct OrientationConstraint
+{
+    bool enabled;
+    bool useStartOrientation;
+    bool axisOnly;
+    rl::math::Rotation target;
+    double tolerance;
+    
+    OrientationConstraint() : enabled(false), useStartOrientation(true), axisOnly(false), target(rl::math::Rotation::Identity()), tolerance(1.0e-3) {}
+};
 
-RL_PLANNER_API void* CreatePlanner()
+// Constraint manifold for planning
+struct PlanningConstraints
 {
-    try
-    {
-        PlannerState* state = new PlannerState();
-        return static_cast<void*>(state);
-    }
-    catch (...)
+    std::vector<JointLock> locks;
+    std::vector<JointCoupling> couplings;
+    OrientationConstraint orientation;
+    
+    bool isActive() const
     {
-        return nullptr;
+        return !locks.empty() || !couplings.empty() || orientation.enabled;
     }
-}
+};
 
-RL_PLANNER_API int LoadKinematics(void* planner, const char* xmlPath)
+// Planning model that projects interpolated and stepped configurations onto the
+// active constraint manifold, so that extension, verification and optimization
+// all stay on the manifold, and that optionally treats configurations closer than
+// a clearance margin to other models as colliding (inflated obstacles). Without
+// active constraints and margin it behaves like SimpleModel.
+class PlanningModel : public rl::plan::SimpleModel
 {
-    if (!planner || !xmlPath)
+public:
+    PlanningModel() : SimpleModel(), constraints(), clearanceMargin(0), collisionChecks(0) {}
+    
+    bool isColliding() override
     {
-        return RL_ERROR_INVALID_POINTER;
+        ++collisionChecks;
+        
+        // Configurations the projection could not bring onto the orientation manifold are invalid
+        if (constraints.orientation.enabled && orientationError(forwardPosition().linear()).norm() >= constraints.orientation.tolerance)
+        {
+            return true;
+        }
+        
+        if (SimpleModel::isColliding())
+        {
+            return true;
+        }
+        
+        if (clearanceMargin <= 0)
+        {
+            return false;
+        }
+        
+        // Engines without distance queries (-1) plan without inflation
+        rl::math::Real clearance = getClearance(clearanceMargin);
+        return clearance >= 0 && clearance < clearanceMargin;
     }
     
-    try
+    // Minimum distance of the robot to other models at the current frames, stopping early
+    // once it is below bound; -1 if the collision engine has no distance queries
+    rl::math::Real getClearance(rl::math::Real bound = 0)
     {
-        PlannerState* state = static_cast<PlannerState*>(planner);
+        rl::sg::DistanceScene* distanceScene = dynamic_cast<rl::sg::DistanceScene*>(this->scene);
+        if (!distanceScene)
+        {
+            return -1;
+        }
         
-        // Try to load as Dynamic model first
-        try
+        rl::math::Real clearance = std::numeric_limits<rl::math::Real>::infinity();
+        
+        for (std::size_t i = 0; i < this->model->getNumBodies(); ++i)
         {
-            rl::mdl::XmlFactory factory;
-            std::shared_ptr<rl::mdl::Model> mdl = factory.create(xmlPath);
+            rl::sg::Body* body = this->model->getBody(i);
             
-            if (std::shared_ptr<rl::mdl::Dynamic> dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(mdl))
+            for (std::size_t j = 0; j < this->scene->getNumModels(); ++j)
             {
-                // Dynamic model - store the model and get kinematics from it
-                // Dynamic inherits from Kinematics, so we can cast it
-                state->mdl = mdl;  // Keep the model alive
-                state->kinematics = std::dynamic_pointer_cast<rl::kin::Kinematics>(dynamic);
-                if (!state->kinematics)
+                rl::sg::Model* other = this->scene->getModel(j);
+                if (other == this->model)
                 {
-                    return RL_ERROR_LOAD_FAILED;
+                    continue;
+                }
+                
+                for (std::size_t k = 0; k < other->getNumBodies(); ++k)
+                {
+                    rl::math::Vector3 point1;
+                    rl::math::Vector3 point2;
+                    clearance = std::min(clearance, distanceScene->distance(body, other->getBody(k), point1, point2));
+                    if (clearance < bound)
+                    {
+                        return clearance;
+                    }
                 }
-                return RL_SUCCESS;
             }
         }
-        catch (const std::exception&)
-        {
-            // Not a Dynamic model file, try loading as Kinematics directly
-            // This is expected for kinematics-only XML files
-        }
-        
-        // Load as Kinematics directly (fallback if not a Dynamic model)
-        state->kinematics = std::shared_ptr<rl::kin::Kinematics>(
-            rl::kin::Kinematics::create(xmlPath)
-        );
         
-        return RL_SUCCESS;
-    }
-    catch (const std::exception& e)
-    {
-        std::cerr << "LoadKinematics exception: " << e.what() << " for file: " << xmlPath << std::endl;
-        return RL_ERROR_LOAD_FAILED;
-    }
-    catch (...)
-    {
-        std::cerr << "LoadKinematics unknown exception for file: " << xmlPath << std::endl;
-        return RL_ERROR_EXCEPTION;
-    }
-}
-
-RL_PLANNER_API int LoadScene(void* planner, const char* xmlPath, int robotModelIndex)
-{
-    if (!planner || !xmlPath)
-    {
-        return RL_ERROR_INVALID_POINTER;
+        return clearance;
     }
     
-    try
+    void interpolate(const rl::math::Vector& q1, const rl::math::Vector& q2, const rl::math::Real& alpha, rl::math::Vector& q) const override
     {
-        PlannerState* state = static_cast<PlannerState*>(planner);
-        
-        // Create scene
-        state->scene = createScene();
-        
-        // Load scene from XML file
-        state->scene->load(xmlPath);
+        SimpleModel::interpolate(q1, q2, alpha, q);
         
-        // Get robot model from scene
-        int numModels = static_cast<int>(state->scene->getNumModels());
-        std::cerr << "LoadScene: Loaded scene with " << numModels << " models, requested index: " << robotModelIndex << std::endl;
-        if (robotModelIndex < 0 || robotModelIndex >= numModels)
+        if (constraints.isActive())
         {
-            std::cerr << "LoadScene: Invalid robotModelIndex " << robotModelIndex << " (valid range: 0 to " << (numModels - 1) << ")" << std::endl;
-            return RL_ERROR_INVALID_PARAMETER;
+            project(q);
         }
-        state->robotModel = state->scene->getModel(robotModelIndex);
+    }
+    
+    void step(const rl::math::Vector& q1, const rl::math::Vector& qdot, rl::math::Vector& q2) const override
+    {
+        SimpleModel::step(q1, qdot, q2);
         
-        // Create planning model based on scene type
-        if (rl::sg::DistanceScene* distanceScene = dynamic_cast<rl::sg::DistanceScene*>(state->scene.get()))
-        {
-            // DistanceScene not typically used for planning, fall back to SimpleModel
-            state->model = std::make_shared<rl::plan::SimpleModel>();
-        }
-        else if (rl::sg::SimpleScene* simpleScene = dynamic_cast<rl::sg::SimpleScene*>(state->scene.get()))
+        if (constraints.isActive())
         {
-            state->model = std::make_shared<rl::plan::SimpleModel>();
+            project(q2);
         }
-        else
+    }
+    
+    // Project configuration onto the constraint manifold
+    // Returns false if the orientation constraint could not be satisfied
+    bool project(rl::math::Vector& q) const
+    {
+        applyJointConstraints(q);
+        
+        if (!constraints.orientation.enabled)
         {
-            return RL_ERROR_LOAD_FAILED;
+            return true;
         }
         
-        // Connect kinematics to model if loaded
-        if (state->kinematics)
+        // Forward kinematics changes model state, which callers reset before use
+        PlanningModel* self = const_cast<PlanningModel*>(this);
+        const int maxIterations = 50;
+        const rl::math::Real lambda = 0.01;
+        
+        for (int i = 0; i < maxIterations; ++i)
         {
-            // Check if kinematics is actually a Dynamic model
-            if (rl::mdl::Dynamic* dynamic = dynamic_cast<rl::mdl::Dynamic*>(state->kinematics.get()))
+            self->setPosition(q);
+            self->updateFrames(false);
+            
+            rl::math::Vector3 error = orientationError(self->forwardPosition().linear());
+            if (error.norm() < constraints.orientation.tolerance)
             {
-                state->model->mdl = dynamic;
-                std::cerr << "LoadScene: Connected Dynamic model to planning model" << std::endl;
+                return true;
             }
-            else
+            
+            self->updateJacobian();
+            rl::math::Matrix jacobian = self->getJacobian().bottomRows(3);
+            
+            // Locked joints do not move, coupled joints move with their reference
+            for (std::size_t j = 0; j < constraints.couplings.size(); ++j)
             {
-                state->model->kin = state->kinematics.get();
-                std::cerr << "LoadScene: Connected Kinematics to planning model" << std::endl;
+                const JointCoupling& coupling = constraints.couplings[j];
+                jacobian.col(coupling.reference) += coupling.ratio * jacobian.col(coupling.joint);
+                jacobian.col(coupling.joint).setZero();
             }
+            for (std::size_t j = 0; j < constraints.locks.size(); ++j)
+            {
+                jacobian.col(constraints.locks[j].joint).setZero();
+            }
+            
+            rl::math::Matrix damped = jacobian * jacobian.transpose() + lambda * lambda * rl::math::Matrix::Identity(3, 3);
+            q += jacobian.transpose() * damped.ldlt().solve(error);
+            clip(q);
+            applyJointConstraints(q);
         }
-        else
+        
+        return false;
+    }
+    
+    // Resolved constraints, active for the duration of a planning call
+    PlanningConstraints constraints;
+    
+    // Minimum distance to other models, active during coarse planning
+    rl::math::Real clearanceMargin;
+    
+    // Number of isColliding calls, reset per planning call
+    std::size_t collisionChecks;
+    
+private:
+    void applyJointConstraints(rl::math::Vector& q) const
+    {
+        for (std::size_t i = 0; i < constraints.locks.size(); ++i)
         {
-            std::cerr << "LoadScene: WARNING - No kinematics loaded, model may not work correctly" << std::endl;
+            q(constraints.locks[i].joint) = constraints.locks[i].value;
         }
         
-        // Connect model to scene
-        state->model->model = state->robotModel;
-        state->model->scene = state->scene.get();
-        
-        // Verify model is properly set up
-        if (!state->model->kin && !state->model->mdl)
+        for (std::size_t i = 0; i < constraints.couplings.size(); ++i)
         {
-            std::cerr << "LoadScene: ERROR - Model has no kinematics or dynamic model set" << std::endl;
-            return RL_ERROR_NOT_INITIALIZED;
+            const JointCoupling& coupling = constraints.couplings[i];
+            q(coupling.joint) = coupling.ratio * q(coupling.reference) + coupling.offset;
         }
-        
-        if (!state->model->model || !state->model->scene)
+    }
+    
+    rl::math::Vector3 orientationError(const rl::math::Rotation& current) const
+    {
+        if (constraints.orientation.axisOnly)
         {
-            std::cerr << "LoadScene: ERROR - Model has no robot model or scene set" << std::endl;
-            return RL_ERROR_NOT_INITIALIZED;
+            return current.col(2).cross(constraints.orientation.target.col(2));
         }
         
-        std::cerr << "LoadScene: Model DOF: " << state->model->getDofPosition() << std::endl;
+        rl::math::AngleAxis rotation(constraints.orientation.target * current.transpose());
+        return rotation.angle() * rotation.axis();
+    }
+};
+
+// Thrown by ConstrainedSampler when no sample can be projected onto the constraint manifold
+class ConstraintProjectionError : public std::runtime_error
+{
+public:
+    ConstraintProjectionError() : std::runtime_error("No sample could be projected onto the constraint manifold") {}
+};
+
+// Sampler that projects uniform samples onto the active constraint manifold
+class ConstrainedSampler : public rl::plan::UniformSampler
+{
+public:
+    ConstrainedSampler() : UniformSampler(), maxAttempts(100), samples(0) {}
+    
+    rl::math::Vector generate() override
+    {
+        PlanningModel* constrained = static_cast<PlanningModel*>(this->model);
+        rl::math::Vector q = UniformSampler::generate();
+        ++samples;
+        
+        if (!constrained->constraints.isActive())
+        {
+            return q;
+        }
         
-        state->initialized = true;
+        // Samples off the manifold are rejected, never returned
+        for (int i = 1; !constrained->project(q); ++i)
+        {
+            if (i >= maxAttempts)
+            {
+                throw ConstraintProjectionError();
+            }
+            
+            q = UniformSampler::generate();
+            ++samples;
+        }
         
-        return RL_SUCCESS;
+        return q;
     }
-    catch (const std::exception& e)
+    
+    // Consecutive failed projections after which planning fails
+    int maxAttempts;
+    
+    // Number of uniform samples drawn, reset per planning call
+    std::size_t samples;
+};
+
+// Nearest neighbor search that counts queries of the wrapped search structure
+class CountingNearestNeighbors : public rl::plan::NearestNeighbors
+{
+public:
+    explicit CountingNearestNeighbors(std::shared_ptr<rl::plan::NearestNeighbors> nearestNeighbors) :
+        NearestNeighbors(nearestNeighbors->isTransformedDistance()), queries(0), nearestNeighbors(nearestNeighbors) {}
+    
+    void clear() override
     {
-        std::cerr << "LoadScene exception: " << e.what() << " for file: " << xmlPath << std::endl;
-        return RL_ERROR_LOAD_FAILED;
+        nearestNeighbors->clear();
     }
-    catch (...)
+    
+    bool empty() const override
     {
-        std::cerr << "LoadScene unknown exception for file: " << xmlPath << std::endl;
-        return RL_ERROR_EXCEPTION;
+        return nearestNeighbors->empty();
     }
-}
-
-// Helper function to create planner based on type
-static std::shared_ptr<rl::plan::Planner> createPlanner(
-    const std::string& plannerType,
-    std::shared_ptr<rl::plan::Sampler> sampler,
-    std::shared_ptr<rl::plan::Verifier> verifier,
-    std::shared_ptr<rl::plan::NearestNeighbors> nearestNeighbors,
-    double delta,
-    double epsilon)
-{
-    std::shared_ptr<rl::plan::Planner> planner;
     
-    if (plannerType == "rrt" || plannerType == "RRT")
+    std::vector<Neighbor> nearest(const rl::math::Vector& query, const std::size_t& k, const bool& sorted = true) const override
     {
-        std::shared_ptr<rl::plan::Rrt> rrt = std::make_shared<rl::plan::Rrt>();
-        rrt->delta = delta;
-        rrt->epsilon = epsilon;
-        rrt->sampler = sampler.get();
-        rrt->setNearestNeighbors(nearestNeighbors.get(), 0);
-        planner = rrt;
+        ++queries;
+        return nearestNeighbors->nearest(query, k, sorted);
     }
-    else if (plannerType == "rrtConnect" || plannerType == "RRTConnect" || 
-             plannerType == "rrtConCon" || plannerType == "RRTConCon")
+    
+    void push(const Value& value) override
     {
-        std::shared_ptr<rl::plan::RrtConCon> rrtConCon = std::make_shared<rl::plan::RrtConCon>();
-        rrtConCon->delta = delta;
-        rrtConCon->epsilon = epsilon;
-        rrtConCon->sampler = sampler.get();
-        rrtConCon->setNearestNeighbors(nearestNeighbors.get(), 0);
-        planner = rrtConCon;
+        nearestNeighbors->push(value);
     }
-    else if (plannerType == "rrtGoalBias" || plannerType == "RRTGoalBias")
+    
+    std::vector<Neighbor> radius(const rl::math::Vector& query, const rl::math::Real& radius, const bool& sorted = true) const override
     {
-        std::shared_ptr<rl::plan::RrtGoalBias> rrtGoalBias = std::make_shared<rl::plan::RrtGoalBias>();
-        rrtGoalBias->delta = delta;
-        rrtGoalBias->epsilon = epsilon;
-        rrtGoalBias->probability = 0.05;
-        rrtGoalBias->sampler = sampler.get();
-        rrtGoalBias->setNearestNeighbors(nearestNeighbors.get(), 0);
-        planner = rrtGoalBias;
+        ++queries;
+        return nearestNeighbors->radius(query, radius, sorted);
     }
-    else if (plannerType == "prm" || plannerType == "PRM")
+    
+    std::size_t size() const override
     {
-        std::shared_ptr<rl::plan::Prm> prm = std::make_shared<rl::plan::Prm>();
-        prm->degree = std::numeric_limits<std::size_t>::max();
-        prm->k = 30;
-        prm->radius = std::numeric_limits<rl::math::Real>::max();
-        prm->sampler = sampler.get();
-        prm->verifier = verifier.get();
-        prm->setNearestNeighbors(nearestNeighbors.get());
-        planner = prm;
+        return nearestNeighbors->size();
     }
     
-    return planner;
-}
+    // Number of nearest and radius queries, reset per planning call
+    mutable std::size_t queries;
+    
+private:
+    std::shared_ptr<rl::plan::NearestNeighbors> nearestNeighbors;
+};
 
-RL_PLANNER_API int LoadPlanXml(void* planner, const char* xmlPath)
+// Resolves planning constraints against the start configuration for the
+// duration of a planning call and clears them again afterwards
+class ConstraintScope
 {
-    if (!planner || !xmlPath)
-    {
-        return RL_ERROR_INVALID_POINTER;
-    }
-    
-    try
+public:
+    ConstraintScope(PlanningModel& model, const PlanningConstraints& spec, const rl::math::Vector& start, int lockedZAxisIndex) :
+        model(model)
     {
-        PlannerState* state = static_cast<PlannerState*>(planner);
-        
-        // Parse XML file
-        rl::xml::DomParser parser;
-        rl::xml::Document document = parser.readFile(xmlPath, "", XML_PARSE_NOENT | XML_PARSE_XINCLUDE);
-        document.substitute(XML_PARSE_NOENT | XML_PARSE_XINCLUDE);
+        int dof = static_cast<int>(start.size());
+        PlanningConstraints resolved;
         
-        // Handle XSLT stylesheets if present (like rlPlanDemo)
-        if ("stylesheet" == document.getRootElement().getName() || "transform" == document.getRootElement().getName())
+        for (std::size_t i = 0; i < spec.locks.size(); ++i)
         {
-            if ("1.0" == document.getRootElement().getProperty("version"))
+            JointLock lock = spec.locks[i];
+            if (lock.joint >= 0 && lock.joint < dof)
             {
-                if (document.getRootElement().hasNamespace() && 
-                    "http://www.w3.org/1999/XSL/Transform" == document.getRootElement().getNamespace().getHref())
+                if (lock.useStartValue)
                 {
-                    rl::xml::Stylesheet stylesheet(document);
-                    document = stylesheet.apply();
+                    lock.value = start(lock.joint);
                 }
+                resolved.locks.push_back(lock);
             }
         }
         
-        rl::xml::Path path(document);
+        if (lockedZAxisIndex >= 0 && lockedZAxisIndex < dof)
+        {
+            JointLock lock = { lockedZAxisIndex, start(lockedZAxisIndex), false };
+            resolved.locks.push_back(lock);
+        }
         
-        // Extract scene file path
-        rl::xml::NodeSet modelScene = path.eval("(/rl/plan|/rlplan)//model/scene").getValue<rl::xml::NodeSet>();
-        if (modelScene.empty())
+        for (std::size_t i = 0; i < spec.couplings.size(); ++i)
         {
-            std::cerr << "LoadPlanXml: No scene element found in XML" << std::endl;
-            return RL_ERROR_LOAD_FAILED;
+            const JointCoupling& coupling = spec.couplings[i];
+            if (coupling.joint >= 0 && coupling.joint < dof && coupling.reference >= 0 && coupling.reference < dof)
+            {
+                resolved.couplings.push_back(coupling);
+            }
         }
-        std::string modelSceneFilename = modelScene[0].getLocalPath(modelScene[0].getProperty("href"));
         
-        // Extract kinematics file path
-        rl::xml::NodeSet modelKinematics = path.eval("(/rl/plan|/rlplan)//model/kinematics").getValue<rl::xml::NodeSet>();
-        if (modelKinematics.empty())
+        resolved.orientation = spec.orientation;
+        if (resolved.orientation.enabled && resolved.orientation.useStartOrientation)
         {
-            std::cerr << "LoadPlanXml: No kinematics element found in XML" << std::endl;
-            return RL_ERROR_LOAD_FAILED;
+            model.setPosition(start);
+            model.updateFrames(false);
+            resolved.orientation.target = model.forwardPosition().linear();
         }
-        std::string modelKinematicsFilename = modelKinematics[0].getLocalPath(modelKinematics[0].getProperty("href"));
         
-        // Extract robot model index
-        std::size_t robotModelIndex = path.eval("number((/rl/plan|/rlplan)//model/model)").getValue<std::size_t>(0);
+        model.constraints = resolved;
+    }
+    
+    ~ConstraintScope()
+    {
+        model.constraints = PlanningConstraints();
+    }
+    
+private:
+    PlanningModel& model;
+};
+
+// Estimated execution cost of straight path segments, each traversed from rest to rest as
+// time parameterization stops at the corners of the path. The dynamics are evaluated at the
+// segment midpoint: the torque left after holding against gravity is split evenly between
+// centrifugal and Coriolis forces, which bound the cruising speed together with the joint
+// speed limits, and inertial forces (mass matrix), which bound the path acceleration. TIME is
+// the duration of the resulting trapezoidal speed profile. ENERGY is the absolute mechanical
+// work against gravity, centrifugal and Coriolis forces at the peak speed plus the kinetic
+// energy gained when accelerating and given back when braking. LENGTH, and any cost without
+// a dynamic model, is the joint space distance of the planning model.
+class DynamicCost
+{
+public:
+    enum Type
+    {
+        TYPE_LENGTH,
+        TYPE_TIME,
+        TYPE_ENERGY
+    };
+    
+    DynamicCost() : type(TYPE_LENGTH), model(nullptr), dynamic(nullptr), speed(), torque() {}
+    
+    rl::math::Real operator()(const rl::math::Vector& q1, const rl::math::Vector& q2) const
+    {
+        if (TYPE_LENGTH == type || !dynamic)
+        {
+            return model->distance(q1, q2);
+        }
         
-        // Extract planner type from root element
-        std::string plannerTypeStr = document.getRootElement().getName();
-        if (plannerTypeStr == "rlplan" || plannerTypeStr == "plan")
+        rl::math::Vector delta = q2 - q1;
+        rl::math::Real length = delta.norm();
+        if (length <= 0)
         {
-            // Get planner type from child elements
-            rl::xml::NodeSet planners = path.eval("(/rl/plan|/rlplan)//rrtConCon|(/rl/plan|/rlplan)//rrt|(/rl/plan|/rlplan)//rrtGoalBias|(/rl/plan|/rlplan)//prm").getValue<rl::xml::NodeSet>();
-            if (!planners.empty())
+            return 0;
+        }
+        
+        // Inertial torques at unit path acceleration, gravity and velocity product torques at unit
+        // path speed, the latter scale with speed squared
+        rl::math::Vector direction = delta / length;
+        dynamic->setPosition(q1 + 0.5 * delta);
+        dynamic->calculateMassMatrix();
+        rl::math::Vector inertia = dynamic->getMassMatrix() * direction;
+        dynamic->setVelocity(direction);
+        dynamic->calculateGravity();
+        rl::math::Vector gravity = dynamic->getGravity();
+        dynamic->calculateCentrifugalCoriolis();
+        rl::math::Vector coriolis = dynamic->getCentrifugalCoriolis();
+        
+        rl::math::Real cruise = std::numeric_limits<rl::math::Real>::infinity();
+        rl::math::Real acceleration = std::numeric_limits<rl::math::Real>::infinity();
+        for (int i = 0; i < delta.size(); ++i)
+        {
+            if (i < speed.size() && speed(i) > 0 && std::abs(direction(i)) > 0)
             {
-                plannerTypeStr = planners[0].getName();
+                cruise = std::min(cruise, speed(i) / std::abs(direction(i)));
             }
-            else
+            
+            if (i < torque.size() && torque(i) > 0)
             {
-                plannerTypeStr = "rrtConCon"; // Default
+                rl::math::Real available = torque(i) - std::abs(gravity(i));
+                if (available <= 0)
+                {
+                    // Joint cannot hold the configuration
+                    return std::numeric_limits<rl::math::Real>::infinity();
+                }
+                if (std::abs(coriolis(i)) > 0)
+                {
+                    cruise = std::min(cruise, std::sqrt(0.5 * available / std::abs(coriolis(i))));
+                }
+                if (std::abs(inertia(i)) > 0)
+                {
+                    acceleration = std::min(acceleration, 0.5 * available / std::abs(inertia(i)));
+                }
             }
         }
         
-        // Extract planner parameters
-        double delta = 1.0;
-        double epsilon = 0.001;
-        int timeoutMs = 120000; // Default 120 seconds
+        if (!std::isfinite(cruise))
+        {
+            cruise = 1;
+        }
         
-        if (path.eval("count((/rl/plan|/rlplan)//delta) > 0").getValue<bool>())
+        // Trapezoidal speed profile, triangular if the segment is too short to reach cruising speed
+        rl::math::Real peak = cruise;
+        rl::math::Real time = length / cruise;
+        if (std::isfinite(acceleration))
         {
-            delta = path.eval("number((/rl/plan|/rlplan)//delta)").getValue<double>(delta);
-            std::string unit = path.eval("string((/rl/plan|/rlplan)//delta/@unit)").getValue<std::string>();
-            if (unit == "deg")
+            if (length * acceleration >= cruise * cruise)
             {
-                delta *= rl::math::constants::deg2rad;
+                time += cruise / acceleration;
+            }
+            else
+            {
+                peak = std::sqrt(length * acceleration);
+                time = 2 * peak / acceleration;
             }
         }
         
-        if (path.eval("count((/rl/plan|/rlplan)//epsilon) > 0").getValue<bool>())
+        if (TYPE_TIME == type)
         {
-            epsilon = path.eval("number((/rl/plan|/rlplan)//epsilon)").getValue<double>(epsilon);
-            std::string unit = path.eval("string((/rl/plan|/rlplan)//epsilon/@unit)").getValue<std::string>();
-            if (unit == "deg")
-            {
-                epsilon *= rl::math::constants::deg2rad;
-            }
+            return time;
         }
         
-        if (path.eval("count((/rl/plan|/rlplan)//duration) > 0").getValue<bool>())
+        rl::math::Real work = 0;
+        for (int i = 0; i < delta.size(); ++i)
         {
-            timeoutMs = static_cast<int>(path.eval("number((/rl/plan|/rlplan)//duration)").getValue<double>(timeoutMs) * 1000.0);
+            work += std::abs((gravity(i) + peak * peak * coriolis(i)) * delta(i));
         }
         
-        // Store planner parameters
-        state->plannerType = plannerTypeStr;
-        state->delta = delta;
-        state->epsilon = epsilon;
-        state->timeoutMs = timeoutMs;
+        // Kinetic energy at peak speed, spent when accelerating and again when braking
+        work += peak * peak * direction.dot(inertia);
+        return work;
+    }
+    
+    // Admissible estimate for A*: joint space distance, time at the joint speed limits, or zero
+    rl::math::Real lowerBound(const rl::math::Vector& q1, const rl::math::Vector& q2) const
+    {
+        if (TYPE_LENGTH == type || !dynamic)
+        {
+            return model->distance(q1, q2);
+        }
         
-        // Load kinematics
-        int result = LoadKinematics(planner, modelKinematicsFilename.c_str());
-        if (result != RL_SUCCESS)
+        if (TYPE_ENERGY == type)
         {
-            return result;
+            return 0;
         }
         
-        // Load scene
-        result = LoadScene(planner, modelSceneFilename.c_str(), static_cast<int>(robotModelIndex));
-        if (result != RL_SUCCESS)
+        rl::math::Real time = 0;
+        for (int i = 0; i < q1.size() && i < speed.size(); ++i)
         {
-            return result;
+            if (speed(i) > 0)
+            {
+                time = std::max(time, std::abs(q2(i) - q1(i)) / speed(i));
+            }
         }
+        return time;
+    }
+    
+    Type type;
+    
+    rl::plan::Model* model;
+    
+    // Dynamic model of the planning model, modified by cost evaluation
+    rl::mdl::Dynamic* dynamic;
+    
+    // Joint speed and torque limits, non-positive or missing entries are unlimited
+    rl::math::Vector speed;
+    rl::math::Vector torque;
+};
+
+// Persistent roadmap for incremental replanning across queries and scene changes
+// Vertices and edges are validated lazily and tagged with the scene version they
+// were checked against; each check also records the workspace bounds of the robot
+// body frames along it, so moving an obstacle only drops the cached results whose
+// bounds come within margin of the body's old or new position. A query re-checks
+// just the vertices and edges on candidate paths, and grows the roadmap where the
+// remaining graph no longer connects start and goal. Candidate paths minimize the
+// path cost, so edges cache their cost at insertion.
+class IncrementalRoadmap
+{
+public:
+    IncrementalRoadmap() : k(10), samplesPerExpansion(50), maxVertices(20000), margin(1.0), sceneVersion(0) {}
+    
+    void clear()
+    {
+        vertices.clear();
+        edges.clear();
+        nearestNeighbors.reset();
+    }
+    
+    // Invalidate all cached validity after the scene changed
+    void invalidate()
+    {
+        ++sceneVersion;
+    }
+    
+    // Invalidate cached validity near an obstacle body that moved from one frame origin to another
+    void invalidate(const rl::math::Vector3& from, const rl::math::Vector3& to)
+    {
+        Box moved(from);
+        moved.extend(to);
+        moved.min().array() -= margin;
+        moved.max().array() += margin;
         
-        // Extract and store start/goal configurations if present
-        if (path.eval("count((/rl/plan|/rlplan)//start/q) > 0").getValue<bool>())
+        for (std::size_t i = 0; i < vertices.size(); ++i)
         {
-            rl::xml::NodeSet start = path.eval("(/rl/plan|/rlplan)//start/q").getValue<rl::xml::NodeSet>();
-            state->start = std::make_shared<rl::math::Vector>(start.size());
-            for (int i = 0; i < start.size(); ++i)
+            if (UNKNOWN != status(vertices[i]) && vertices[i].bounds.intersects(moved))
             {
-                (*state->start)(i) = std::atof(start[i].getContent().c_str());
-                if ("deg" == start[i].getProperty("unit"))
-                {
-                    (*state->start)(i) *= rl::math::constants::deg2rad;
-                }
+                vertices[i].checkedVersion = -1;
             }
         }
         
-        if (path.eval("count((/rl/plan|/rlplan)//goal/q) > 0").getValue<bool>())
+        for (std::size_t i = 0; i < edges.size(); ++i)
         {
-            rl::xml::NodeSet goal = path.eval("(/rl/plan|/rlplan)//goal/q").getValue<rl::xml::NodeSet>();
-            state->goal = std::make_shared<rl::math::Vector>(goal.size());
-            for (int i = 0; i < goal.size(); ++i)
+            if (UNKNOWN != status(edges[i]) && edges[i].bounds.intersects(moved))
             {
-                (*state->goal)(i) = std::atof(goal[i].getContent().c_str());
-                if ("deg" == goal[i].getProperty("unit"))
+                edges[i].checkedVersion = -1;
+            }
+        }
+    }
+    
+    // Nearest neighbor queries since the last reset
+    std::size_t getQueries() const
+    {
+        return nearestNeighbors ? nearestNeighbors->queries : 0;
+    }
+    
+    void resetQueries()
+    {
+        if (nearestNeighbors)
+        {
+            nearestNeighbors->queries = 0;
+        }
+    }
+    
+    std::size_t size() const
+    {
+        return vertices.size();
+    }
+    
+    bool solve(rl::plan::Model* model, rl::plan::Sampler* sampler, rl::plan::Verifier* verifier, const DynamicCost& cost,
+        const rl::math::Vector& start, const rl::math::Vector& goal,
+        std::chrono::steady_clock::duration duration, rl::plan::VectorList& path)
+    {
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + duration;
+        
+        std::size_t startVertex = addVertex(model, cost, start);
+        std::size_t goalVertex = addVertex(model, cost, goal);
+        
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            std::vector<std::size_t> candidate;
+            
+            if (!search(cost, startVertex, goalVertex, candidate))
+            {
+                if (vertices.size() >= maxVertices)
                 {
-                    (*state->goal)(i) *= rl::math::constants::deg2rad;
+                    return false;
+                }
+                
+                for (std::size_t i = 0; i < samplesPerExpansion; ++i)
+                {
+                    addVertex(model, cost, sampler->generate());
+                }
+                continue;
+            }
+            
+            // Cached results near a body larger than the margin may be stale, so the path is
+            // verified again at full resolution before it is returned
+            if (verifyPath(model, verifier, candidate) && confirmPath(model, verifier, candidate))
+            {
+                path.clear();
+                for (std::size_t i = 0; i < candidate.size(); ++i)
+                {
+                    path.push_back(vertices[candidate[i]].q);
                 }
+                return true;
             }
         }
         
-        // Create persistent planner components
-        state->sampler = std::make_shared<rl::plan::UniformSampler>();
-        state->sampler->model = state->model.get();
+        return false;
+    }
+    
+    std::size_t k;
+    std::size_t samplesPerExpansion;
+    std::size_t maxVertices;
+    
+    // Distance added to the recorded bounds of the robot body frames and to the moved body's
+    // frame origin, covering the extent of robot links and obstacles about their frames; results
+    // left stale by a smaller margin cost extra searches, returned paths are always re-verified
+    rl::math::Real margin;
+    
+private:
+    enum Status { UNKNOWN, VALID, INVALID };
+    
+    typedef Eigen::AlignedBox<rl::math::Real, 3> Box;
+    
+    struct Vertex
+    {
+        rl::math::Vector q;
+        std::vector<std::size_t> edges;
+        int checkedVersion;
+        bool valid;
+        Box bounds;
+    };
+    
+    struct Edge
+    {
+        std::size_t u;
+        std::size_t v;
+        rl::math::Real distance;
+        rl::math::Real cost;
+        int checkedVersion;
+        bool valid;
+        Box bounds;
+    };
+    
+    template<typename Element>
+    Status status(const Element& element) const
+    {
+        if (element.checkedVersion != sceneVersion)
+        {
+            return UNKNOWN;
+        }
+        return element.valid ? VALID : INVALID;
+    }
+    
+    std::size_t addVertex(rl::plan::Model* model, const DynamicCost& cost, const rl::math::Vector& q)
+    {
+        if (!nearestNeighbors)
+        {
+            nearestNeighbors = std::make_shared<CountingNearestNeighbors>(std::make_shared<rl::plan::KdtreeNearestNeighbors>(model));
+        }
         
-        state->verifier = std::make_shared<rl::plan::RecursiveVerifier>();
-        state->verifier->delta = delta;
-        state->verifier->model = state->model.get();
+        std::vector<rl::plan::NearestNeighbors::Neighbor> neighbors = nearestNeighbors->nearest(q, k);
         
-        state->nearestNeighbors = std::make_shared<rl::plan::LinearNearestNeighbors>(state->model.get());
+        // Reuse existing vertex for repeated start/goal configurations
+        if (!neighbors.empty())
+        {
+            std::size_t nearest = boost::any_cast<std::size_t>(neighbors.front().second.second);
+            if (model->distance(q, vertices[nearest].q) <= std::numeric_limits<rl::math::Real>::epsilon())
+            {
+                return nearest;
+            }
+        }
         
-        state->optimizer = std::make_shared<rl::plan::SimpleOptimizer>();
-        state->optimizer->model = state->model.get();
-        state->optimizer->verifier = state->verifier.get();
+        Vertex vertex = { q, std::vector<std::size_t>(), -1, false, Box() };
+        vertices.push_back(vertex);
+        std::size_t index = vertices.size() - 1;
+        nearestNeighbors->push(rl::plan::NearestNeighbors::Value(&vertices.back().q, index));
         
-        // Create planner
-        state->planner = createPlanner(plannerTypeStr, state->sampler, state->verifier, state->nearestNeighbors, delta, epsilon);
-        if (!state->planner)
+        for (std::size_t i = 0; i < neighbors.size(); ++i)
         {
-            std::cerr << "LoadPlanXml: Failed to create planner of type: " << plannerTypeStr << std::endl;
-            return RL_ERROR_LOAD_FAILED;
+            std::size_t neighbor = boost::any_cast<std::size_t>(neighbors[i].second.second);
+            Edge edge = { index, neighbor, model->distance(q, vertices[neighbor].q), cost(q, vertices[neighbor].q), -1, false, Box() };
+            edges.push_back(edge);
+            vertices[index].edges.push_back(edges.size() - 1);
+            vertices[neighbor].edges.push_back(edges.size() - 1);
         }
         
-        state->planner->model = state->model.get();
-        state->planner->duration = std::chrono::milliseconds(timeoutMs);
+        return index;
+    }
+    
+    // Extend bounds by the robot body frame origins at q
+    static void extendBounds(rl::plan::Model* model, const rl::math::Vector& q, Box& bounds)
+    {
+        model->setPosition(q);
+        model->updateFrames();
         
-        if (state->start)
+        for (std::size_t i = 0; i < model->model->getNumBodies(); ++i)
         {
-            state->planner->start = state->start.get();
+            rl::math::Transform frame;
+            model->model->getBody(i)->getFrame(frame);
+            bounds.extend(frame.translation());
         }
-        if (state->goal)
+    }
+    
+    // A* over vertices and edges not known to be invalid in the current scene
+    bool search(const DynamicCost& cost, std::size_t startVertex, std::size_t goalVertex, std::vector<std::size_t>& result) const
+    {
+        typedef std::pair<rl::math::Real, std::size_t> Entry;
+        std::vector<rl::math::Real> pathCost(vertices.size(), std::numeric_limits<rl::math::Real>::infinity());
+        std::vector<std::size_t> parent(vertices.size(), vertices.size());
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+        
+        pathCost[startVertex] = 0;
+        open.push(Entry(cost.lowerBound(vertices[startVertex].q, vertices[goalVertex].q), startVertex));
+        
+        while (!open.empty())
         {
-            state->planner->goal = state->goal.get();
+            std::size_t current = open.top().second;
+            open.pop();
+            
+            if (current == goalVertex)
+            {
+                result.clear();
+                for (std::size_t v = goalVertex; v != startVertex; v = parent[v])
+                {
+                    result.push_back(v);
+                }
+                result.push_back(startVertex);
+                std::reverse(result.begin(), result.end());
+                return true;
+            }
+            
+            for (std::size_t i = 0; i < vertices[current].edges.size(); ++i)
+            {
+                const Edge& edge = edges[vertices[current].edges[i]];
+                std::size_t next = (edge.u == current) ? edge.v : edge.u;
+                
+                if (INVALID == status(edge) || INVALID == status(vertices[next]))
+                {
+                    continue;
+                }
+                
+                rl::math::Real nextCost = pathCost[current] + edge.cost;
+                if (nextCost < pathCost[next])
+                {
+                    pathCost[next] = nextCost;
+                    parent[next] = current;
+                    open.push(Entry(nextCost + cost.lowerBound(vertices[next].q, vertices[goalVertex].q), next));
+                }
+            }
         }
         
-        std::cerr << "LoadPlanXml: Successfully loaded plan XML with planner type: " << plannerTypeStr << std::endl;
-        
-        return RL_SUCCESS;
+        return false;
     }
-    catch (const std::exception& e)
+    
+    // Check vertices first, then edges, of candidate path in the current scene
+    bool verifyPath(rl::plan::Model* model, rl::plan::Verifier* verifier, const std::vector<std::size_t>& candidate)
     {
-        std::cerr << "LoadPlanXml exception: " << e.what() << " for file: " << xmlPath << std::endl;
-        return RL_ERROR_LOAD_FAILED;
+        for (std::size_t i = 0; i < candidate.size(); ++i)
+        {
+            Vertex& vertex = vertices[candidate[i]];
+            if (UNKNOWN == status(vertex))
+            {
+                vertex.bounds.setEmpty();
+                extendBounds(model, vertex.q, vertex.bounds);
+                vertex.valid = model->isValid(vertex.q) && !model->isColliding();
+                vertex.checkedVersion = sceneVersion;
+            }
+            if (!vertex.valid)
+            {
+                return false;
+            }
+        }
+        
+        for (std::size_t i = 1; i < candidate.size(); ++i)
+        {
+            Edge& edge = edges[findEdge(candidate[i - 1], candidate[i])];
+            if (UNKNOWN == status(edge))
+            {
+                edge.valid = !verifier->isColliding(vertices[edge.u].q, vertices[edge.v].q, edge.distance);
+                edge.checkedVersion = sceneVersion;
+                
+                // Swept bounds at the verifier's resolution
+                int steps = std::max(1, static_cast<int>(std::ceil(edge.distance / verifier->delta)));
+                rl::math::Vector q(vertices[edge.u].q.size());
+                edge.bounds.setEmpty();
+                for (int j = 0; j <= steps; ++j)
+                {
+                    model->interpolate(vertices[edge.u].q, vertices[edge.v].q, static_cast<rl::math::Real>(j) / steps, q);
+                    extendBounds(model, q, edge.bounds);
+                }
+            }
+            if (!edge.valid)
+            {
+                return false;
+            }
+        }
+        
+        return true;
     }
-    catch (...)
+    
+    // Check all vertices and edges of a candidate path in the current scene, ignoring cached results
+    // A failing element is cached as invalid, so the next search avoids it
+    bool confirmPath(rl::plan::Model* model, rl::plan::Verifier* verifier, const std::vector<std::size_t>& candidate)
+    {
+        for (std::size_t i = 0; i < candidate.size(); ++i)
+        {
+            Vertex& vertex = vertices[candidate[i]];
+            model->setPosition(vertex.q);
+            model->updateFrames();
+            if (model->isColliding())
+            {
+                vertex.valid = false;
+                return false;
+            }
+        }
+        
+        for (std::size_t i = 1; i < candidate.size(); ++i)
+        {
+            Edge& edge = edges[findEdge(candidate[i - 1], candidate[i])];
+            if (verifier->isColliding(vertices[edge.u].q, vertices[edge.v].q, edge.distance))
+            {
+                edge.valid = false;
+                return false;
+            }
+        }
+        
+        return true;
+    }
+    
+    std::size_t findEdge(std::size_t u, std::size_t v) const
+    {
+        for (std::size_t i = 0; i < vertices[u].edges.size(); ++i)
+        {
+            const Edge& edge = edges[vertices[u].edges[i]];
+            if ((edge.u == u && edge.v == v) || (edge.u == v && edge.v == u))
+            {
+                return vertices[u].edges[i];
+            }
+        }
+        return edges.size();
+    }
+    
+    // Deque keeps vertex configurations in place for the nearest neighbor search
+    std::deque<Vertex> vertices;
+    std::vector<Edge> edges;
+    std::shared_ptr<CountingNearestNeighbors> nearestNeighbors;
+    int sceneVersion;
+};
+
+// Per-joint velocity, acceleration, jerk and torque limits for time parameterization and dynamic path cost
+// Empty vectors use defaults; jerk and torque <= 0 mean unlimited
+struct JointLimits
+{
+    rl::math::Vector velocity;
+    rl::math::Vector acceleration;
+    rl::math::Vector jerk;
+    rl::math::Vector torque;
+};
+
+// Time-optimal parameterization of a piecewise linear joint-space path along a fine
+// grid in path length (TOPP-RA): a backward pass computes the controllable sets of
+// squared path velocity, a forward pass greedily picks the maximum path acceleration
+// that stays controllable. Jerk limits are enforced by locally reducing the
+// acceleration limits and repeating until the profile satisfies them.
+class TimeOptimalParameterization
+{
+public:
+    TimeOptimalParameterization() : gridPoints(1000), maxJerkIterations(10) {}
+    
+    // Returns false if the path cannot be parameterized within the limits, including jerk limits
+    // still violated after maxJerkIterations reductions
+    bool process(const std::vector<rl::math::Vector>& waypoints, const JointLimits& limits)
+    {
+        if (waypoints.empty())
+        {
+            return false;
+        }
+        
+        buildGrid(waypoints);
+        
+        std::size_t dof = waypoints[0].size();
+        velocityLimit = limitOrDefault(limits.velocity, dof, 1.0);
+        accelerationLimit = limitOrDefault(limits.acceleration, dof, 2.0);
+        rl::math::Vector jerkLimit = limitOrDefault(limits.jerk, dof, 0.0);
+        accelerationScale.assign(q.size(), 1.0);
+        
+        for (int iteration = 0; iteration <= maxJerkIterations; ++iteration)
+        {
+            if (!computeProfile())
+            {
+                return false;
+            }
+            
+            if (!reduceForJerk(jerkLimit))
+            {
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    // Time of every grid point
+    const std::vector<rl::math::Real>& getTimes() const
+    {
+        return t;
+    }
+    
+    // Grid index of each input waypoint
+    const std::vector<std::size_t>& getWaypointIndices() const
+    {
+        return waypointIndex;
+    }
+    
+    rl::math::Real getDuration() const
+    {
+        return t.empty() ? 0 : t.back();
+    }
+    
+    // Position and velocity at time
+    void sample(rl::math::Real time, rl::math::Vector& position, rl::math::Vector& velocity) const
+    {
+        std::size_t i = std::upper_bound(t.begin(), t.end(), time) - t.begin();
+        i = (i == 0) ? 0 : std::min(i - 1, q.size() - 1);
+        
+        if (i + 1 >= q.size() || ds[i] <= 0)
+        {
+            position = q[i];
+            velocity = da[i] * std::sqrt(x[i]);
+            return;
+        }
+        
+        rl::math::Real tau = time - t[i];
+        rl::math::Real sdot = std::sqrt(x[i]);
+        rl::math::Real alpha = std::min<rl::math::Real>(1, std::max<rl::math::Real>(0, (sdot * tau + 0.5 * u[i] * tau * tau) / ds[i]));
+        position = (1 - alpha) * q[i] + alpha * q[i + 1];
+        velocity = (q[i + 1] - q[i]) / ds[i] * std::max<rl::math::Real>(0, sdot + u[i] * tau);
+    }
+    
+    std::size_t gridPoints;
+    int maxJerkIterations;
+    
+private:
+    static rl::math::Vector limitOrDefault(const rl::math::Vector& limit, std::size_t dof, rl::math::Real value)
+    {
+        if (static_cast<std::size_t>(limit.size()) == dof)
+        {
+            return limit;
+        }
+        return rl::math::Vector::Constant(dof, value);
+    }
+    
+    void buildGrid(const std::vector<rl::math::Vector>& waypoints)
+    {
+        rl::math::Real length = 0;
+        for (std::size_t i = 1; i < waypoints.size(); ++i)
+        {
+            length += (waypoints[i] - waypoints[i - 1]).norm();
+        }
+        rl::math::Real step = std::max<rl::math::Real>(length / gridPoints, 1.0e-6);
+        
+        q.clear();
+        waypointIndex.clear();
+        q.push_back(waypoints[0]);
+        waypointIndex.push_back(0);
+        
+        for (std::size_t i = 1; i < waypoints.size(); ++i)
+        {
+            int steps = std::max(1, static_cast<int>(std::ceil((waypoints[i] - waypoints[i - 1]).norm() / step)));
+            for (int j = 1; j <= steps; ++j)
+            {
+                rl::math::Real alpha = static_cast<rl::math::Real>(j) / steps;
+                q.push_back((1 - alpha) * waypoints[i - 1] + alpha * waypoints[i]);
+            }
+            waypointIndex.push_back(q.size() - 1);
+        }
+        
+        std::size_t n = q.size();
+        ds.assign(n, 0);
+        for (std::size_t i = 0; i + 1 < n; ++i)
+        {
+            ds[i] = (q[i + 1] - q[i]).norm();
+        }
+        
+        // First and second path derivatives by finite differences, curvature at corners
+        da.assign(n, rl::math::Vector::Zero(q[0].size()));
+        db.assign(n, rl::math::Vector::Zero(q[0].size()));
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            rl::math::Vector left = (i > 0 && ds[i - 1] > 0) ? rl::math::Vector((q[i] - q[i - 1]) / ds[i - 1]) : rl::math::Vector();
+            rl::math::Vector right = (i + 1 < n && ds[i] > 0) ? rl::math::Vector((q[i + 1] - q[i]) / ds[i]) : rl::math::Vector();
+            
+            if (left.size() > 0 && right.size() > 0)
+            {
+                da[i] = 0.5 * (left + right);
+                db[i] = 2 * (right - left) / (ds[i - 1] + ds[i]);
+            }
+            else if (left.size() > 0)
+            {
+                da[i] = left;
+            }
+            else if (right.size() > 0)
+            {
+                da[i] = right;
+            }
+        }
+    }
+    
+    // Constraints alpha * u + beta * x <= gamma on path acceleration u and squared path velocity x
+    struct Constraint
+    {
+        rl::math::Real alpha;
+        rl::math::Real beta;
+        rl::math::Real gamma;
+    };
+    
+    void pathConstraints(std::size_t i, std::vector<Constraint>& constraints) const
+    {
+        constraints.clear();
+        
+        rl::math::Real maxX = std::numeric_limits<rl::math::Real>::max();
+        for (int j = 0; j < da[i].size(); ++j)
+        {
+            rl::math::Real limit = accelerationLimit(j) * accelerationScale[i];
+            Constraint upper = { da[i](j), db[i](j), limit };
+            Constraint lower = { -da[i](j), -db[i](j), limit };
+            constraints.push_back(upper);
+            constraints.push_back(lower);
+            
+            if (std::abs(da[i](j)) > 0)
+            {
+                maxX = std::min(maxX, velocityLimit(j) * velocityLimit(j) / (da[i](j) * da[i](j)));
+            }
+        }
+        
+        Constraint velocity = { 0, 1, std::min<rl::math::Real>(maxX, 1.0e12) };
+        Constraint positive = { 0, -1, 0 };
+        constraints.push_back(velocity);
+        constraints.push_back(positive);
+    }
+    
+    // Minimize or maximize x over the polygon given by constraints by vertex enumeration
+    static bool solveLinearProgram(const std::vector<Constraint>& constraints, bool maximize, rl::math::Real& result)
+    {
+        const rl::math::Real tolerance = 1.0e-9;
+        bool found = false;
+        
+        for (std::size_t k = 0; k < constraints.size(); ++k)
+        {
+            for (std::size_t l = k + 1; l < constraints.size(); ++l)
+            {
+                const Constraint& a = constraints[k];
+                const Constraint& b = constraints[l];
+                rl::math::Real det = a.alpha * b.beta - a.beta * b.alpha;
+                if (std::abs(det) < tolerance)
+                {
+                    continue;
+                }
+                
+                rl::math::Real u = (a.gamma * b.beta - a.beta * b.gamma) / det;
+                rl::math::Real x = (a.alpha * b.gamma - a.gamma * b.alpha) / det;
+                
+                bool feasible = true;
+                for (std::size_t m = 0; m < constraints.size() && feasible; ++m)
+                {
+                    const Constraint& c = constraints[m];
+                    feasible = c.alpha * u + c.beta * x <= c.gamma + tolerance * std::max<rl::math::Real>(1, std::abs(c.gamma));
+                }
+                
+                if (feasible && (!found || (maximize ? x > result : x < result)))
+                {
+                    result = x;
+                    found = true;
+                }
+            }
+        }
+        
+        return found;
+    }
+    
+    bool computeProfile()
+    {
+        std::size_t n = q.size();
+        std::vector<rl::math::Real> lower(n, 0);
+        std::vector<rl::math::Real> upper(n, 0);
+        std::vector<Constraint> constraints;
+        
+        // Backward pass: controllable sets, ending at rest
+        for (std::size_t k = n - 1; k-- > 0;)
+        {
+            pathConstraints(k, constraints);
+            
+            if (ds[k] <= 0)
+            {
+                lower[k] = lower[k + 1];
+                upper[k] = upper[k + 1];
+                continue;
+            }
+            
+            Constraint reachUpper = { 2 * ds[k], 1, upper[k + 1] };
+            Constraint reachLower = { -2 * ds[k], -1, -lower[k + 1] };
+            constraints.push_back(reachUpper);
+            constraints.push_back(reachLower);
+            
+            if (!solveLinearProgram(constraints, true, upper[k]) || !solveLinearProgram(constraints, false, lower[k]))
+            {
+                return false;
+            }
+            lower[k] = std::max<rl::math::Real>(0, lower[k]);
+        }
+        
+        // Forward pass: start at rest, maximum controllable acceleration
+        if (lower[0] > 0)
+        {
+            return false;
+        }
+        
+        x.assign(n, 0);
+        u.assign(n, 0);
+        t.assign(n, 0);
+        
+        for (std::size_t k = 0; k + 1 < n; ++k)
+        {
+            if (ds[k] > 0)
+            {
+                rl::math::Real uMin = (lower[k + 1] - x[k]) / (2 * ds[k]);
+                rl::math::Real uMax = (upper[k + 1] - x[k]) / (2 * ds[k]);
+                
+                for (int j = 0; j < da[k].size(); ++j)
+                {
+                    rl::math::Real limit = accelerationLimit(j) * accelerationScale[k];
+                    if (std::abs(da[k](j)) > 0)
+                    {
+                        rl::math::Real bound1 = (limit - db[k](j) * x[k]) / da[k](j);
+                        rl::math::Real bound2 = (-limit - db[k](j) * x[k]) / da[k](j);
+                        uMin = std::max(uMin, std::min(bound1, bound2));
+                        uMax = std::min(uMax, std::max(bound1, bound2));
+                    }
+                }
+                
+                u[k] = (uMax >= uMin) ? uMax : uMin;
+                x[k + 1] = std::min(upper[k + 1], std::max<rl::math::Real>(0, x[k] + 2 * ds[k] * u[k]));
+                u[k] = (x[k + 1] - x[k]) / (2 * ds[k]);
+                
+                rl::math::Real speed = std::sqrt(x[k]) + std::sqrt(x[k + 1]);
+                t[k + 1] = t[k] + (speed > 0 ? 2 * ds[k] / speed : 0);
+            }
+            else
+            {
+                x[k + 1] = x[k];
+                t[k + 1] = t[k];
+            }
+        }
+        
+        return true;
+    }
+    
+    // Reduce acceleration limits around grid points exceeding jerk limits
+    // Returns true if limits were changed and the profile must be recomputed
+    bool reduceForJerk(const rl::math::Vector& jerkLimit)
+    {
+        bool changed = false;
+        std::size_t n = q.size();
+        
+        for (std::size_t k = 0; k + 2 < n; ++k)
+        {
+            rl::math::Real dt = t[k + 1] - t[k];
+            if (dt <= 0)
+            {
+                continue;
+            }
+            
+            rl::math::Vector acceleration0 = da[k] * u[k] + db[k] * x[k];
+            rl::math::Vector acceleration1 = da[k + 1] * u[k + 1] + db[k + 1] * x[k + 1];
+            
+            for (int j = 0; j < jerkLimit.size(); ++j)
+            {
+                if (jerkLimit(j) > 0 && std::abs(acceleration1(j) - acceleration0(j)) / dt > jerkLimit(j))
+                {
+                    accelerationScale[k] *= 0.7;
+                    accelerationScale[k + 1] *= 0.7;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+        
+        return changed;
+    }
+    
+    std::vector<rl::math::Vector> q;
+    std::vector<rl::math::Vector> da;
+    std::vector<rl::math::Vector> db;
+    std::vector<rl::math::Real> ds;
+    std::vector<rl::math::Real> x;
+    std::vector<rl::math::Real> u;
+    std::vector<rl::math::Real> t;
+    std::vector<rl::math::Real> accelerationScale;
+    std::vector<std::size_t> waypointIndex;
+    rl::math::Vector velocityLimit;
+    rl::math::Vector accelerationLimit;
+};
+
+// Corner blending of optimizer output. Each interior waypoint is replaced by a
+// quadratic Bezier blend between points at distance radius on the adjacent
+// segments. A blend that collides is retried with half the radius and finally
+// replaced by the original corner, so the path falls back to the polyline only
+// locally. Blends stay inside the convex hull of the corner, hence within joint limits.
+class PathSmoother
+{
+public:
+    PathSmoother() : model(nullptr), verifier(nullptr), radius(0), samples(8), attempts(3) {}
+    
+    void process(rl::plan::VectorList& path)
+    {
+        if (path.size() < 3 || radius <= 0 || samples < 2)
+        {
+            return;
+        }
+        
+        std::vector<rl::math::Vector> polyline(path.begin(), path.end());
+        rl::plan::VectorList result;
+        result.push_back(polyline.front());
+        
+        for (std::size_t i = 1; i + 1 < polyline.size(); ++i)
+        {
+            std::vector<rl::math::Vector> blend;
+            rl::math::Real blendRadius = radius;
+            bool blended = false;
+            
+            for (int attempt = 0; attempt < attempts && !blended; ++attempt, blendRadius *= 0.5)
+            {
+                blended = createBlend(polyline[i - 1], polyline[i], polyline[i + 1], blendRadius, blend) && isFree(blend);
+            }
+            
+            if (blended)
+            {
+                result.insert(result.end(), blend.begin(), blend.end());
+            }
+            else
+            {
+                result.push_back(polyline[i]);
+            }
+        }
+        
+        result.push_back(polyline.back());
+        path = result;
+    }
+    
+    PlanningModel* model;
+    
+    rl::plan::Verifier* verifier;
+    
+    // Distance from the corner at which the blend starts, limited to half of each adjacent segment
+    rl::math::Real radius;
+    
+    // Number of segments per blend
+    int samples;
+    
+    // Blend attempts per corner, halving the radius each time
+    int attempts;
+    
+private:
+    bool createBlend(const rl::math::Vector& q0, const rl::math::Vector& q1, const rl::math::Vector& q2,
+        rl::math::Real blendRadius, std::vector<rl::math::Vector>& blend) const
+    {
+        rl::math::Real distance0 = model->distance(q1, q0);
+        rl::math::Real distance2 = model->distance(q1, q2);
+        if (distance0 <= 0 || distance2 <= 0)
+        {
+            return false;
+        }
+        
+        rl::math::Vector a(q1.size());
+        rl::math::Vector b(q1.size());
+        model->interpolate(q1, q0, std::min(blendRadius / distance0, static_cast<rl::math::Real>(0.5)), a);
+        model->interpolate(q1, q2, std::min(blendRadius / distance2, static_cast<rl::math::Real>(0.5)), b);
+        
+        blend.clear();
+        blend.reserve(samples + 1);
+        for (int k = 0; k <= samples; ++k)
+        {
+            rl::math::Real t = static_cast<rl::math::Real>(k) / samples;
+            rl::math::Vector q = (1 - t) * (1 - t) * a + 2 * t * (1 - t) * q1 + t * t * b;
+            
+            if (model->constraints.isActive() && !model->project(q))
+            {
+                return false;
+            }
+            
+            blend.push_back(q);
+        }
+        
+        return true;
+    }
+    
+    // Check blend samples and the segments between them
+    bool isFree(const std::vector<rl::math::Vector>& blend) const
+    {
+        for (std::size_t k = 0; k < blend.size(); ++k)
+        {
+            model->setPosition(blend[k]);
+            model->updateFrames();
+            if (!model->isValid(blend[k]) || model->isColliding())
+            {
+                return false;
+            }
+            
+            if (k > 0 && verifier->isColliding(blend[k - 1], blend[k], model->distance(blend[k - 1], blend[k])))
+            {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+};
+
+// Private scene, kinematics and planning model for collision checking on a worker thread.
+// Scenes keep the state of the last query, so concurrent verifiers need separate copies.
+struct VerificationContext
+{
+    std::shared_ptr<rl::sg::Scene> scene;
+    std::shared_ptr<rl::kin::Kinematics> kinematics;
+    std::shared_ptr<rl::mdl::Model> mdl;
+    PlanningModel model;
+    rl::plan::RecursiveVerifier verifier;
+    DynamicCost cost;
+};
+
+// Time-budgeted random shortcutting. Each round samples one shortcut per verification
+// context between random points on the path, either a full shortcut (straight segment)
+// or a partial shortcut moving a single joint onto a straight line, and checks all of
+// them in parallel on workers that persist for the whole call. Non-overlapping shortcuts
+// that are collision-free and reduce the cost are applied. Rounds stop at the time
+// budget; full shortcuts also remove redundant vertices, so no unbounded pass follows.
+class ParallelShortcutOptimizer
+{
+public:
+    ParallelShortcutOptimizer() : model(nullptr), verifier(nullptr), cost(), contexts(), duration(std::chrono::seconds(1)),
+        partialRatio(0.5), maxFailures(100), applied(0), generator(std::random_device()()) {}
+    
+    void seed(std::mt19937::result_type value)
+    {
+        generator.seed(value);
+    }
+    
+    void process(rl::plan::VectorList& path)
+    {
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + duration;
+        std::vector<rl::math::Vector> points(path.begin(), path.end());
+        std::size_t workerCount = std::max<std::size_t>(1, contexts.size());
+        std::vector<Shortcut> shortcuts(workerCount);
+        int failures = 0;
+        
+        if (points.size() < 3)
+        {
+            return;
+        }
+        
+        std::unique_ptr<Workers> workers(contexts.empty() ? nullptr : new Workers(contexts, points, shortcuts));
+        
+        while (points.size() >= 3 && failures < maxFailures && std::chrono::steady_clock::now() < deadline)
+        {
+            for (std::size_t i = 0; i < workerCount; ++i)
+            {
+                sample(points, shortcuts[i]);
+            }
+            
+            if (workers)
+            {
+                workers->run();
+            }
+            else
+            {
+                evaluate(model, verifier, &cost, points, shortcuts[0]);
+            }
+            
+            std::size_t count = apply(shortcuts, points);
+            applied += count;
+            failures = (count > 0) ? 0 : failures + 1;
+        }
+        
+        workers.reset();
+        path.assign(points.begin(), points.end());
+    }
+    
+    PlanningModel* model;
+    
+    rl::plan::Verifier* verifier;
+    
+    // Cost minimized on model, contexts use their own copy
+    DynamicCost cost;
+    
+    // One shortcut is checked per context and round; sequential on model if empty
+    std::vector<VerificationContext*> contexts;
+    
+    // Optimization time budget
+    std::chrono::steady_clock::duration duration;
+    
+    // Probability of sampling a partial (single joint) shortcut
+    rl::math::Real partialRatio;
+    
+    // Stop after this many consecutive rounds without improvement
+    int maxFailures;
+    
+    // Number of shortcuts applied by process
+    std::size_t applied;
+    
+private:
+    struct Shortcut
+    {
+        // Path vertices kept before and after the replaced part
+        std::size_t first;
+        std::size_t last;
+        
+        // Positions of shortcut endpoints on segments (first, first + 1) and (last - 1, last)
+        rl::math::Real alpha1;
+        rl::math::Real alpha2;
+        
+        // Joint of a partial shortcut, -1 for a full shortcut
+        int joint;
+        
+        // Replacement including both endpoints
+        std::vector<rl::math::Vector> points;
+        rl::math::Real gain;
+        bool valid;
+    };
+    
+    void sample(const std::vector<rl::math::Vector>& points, Shortcut& shortcut)
+    {
+        std::uniform_real_distribution<rl::math::Real> uniform(0, 1);
+        std::size_t segment1 = std::uniform_int_distribution<std::size_t>(0, points.size() - 3)(generator);
+        std::size_t segment2 = std::uniform_int_distribution<std::size_t>(segment1 + 1, points.size() - 2)(generator);
+        
+        shortcut.first = segment1;
+        shortcut.last = segment2 + 1;
+        shortcut.alpha1 = uniform(generator);
+        shortcut.alpha2 = uniform(generator);
+        shortcut.joint = uniform(generator) < partialRatio ?
+            std::uniform_int_distribution<int>(0, static_cast<int>(points.front().size()) - 1)(generator) : -1;
+        shortcut.gain = 0;
+        shortcut.valid = false;
+    }
+    
+    // One thread per verification context, each evaluating its shortcut of a round
+    // against the current points; run() starts a round and returns when all are done
+    class Workers
+    {
+    public:
+        Workers(const std::vector<VerificationContext*>& contexts, const std::vector<rl::math::Vector>& points, std::vector<Shortcut>& shortcuts) :
+            points(points), shortcuts(shortcuts), round(0), pending(0), stop(false)
+        {
+            for (std::size_t i = 0; i < contexts.size(); ++i)
+            {
+                threads.emplace_back(&Workers::work, this, contexts[i], i);
+            }
+        }
+        
+        ~Workers()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stop = true;
+            }
+            started.notify_all();
+            
+            for (std::size_t i = 0; i < threads.size(); ++i)
+            {
+                threads[i].join();
+            }
+        }
+        
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            pending = threads.size();
+            ++round;
+            started.notify_all();
+            finished.wait(lock, [this] { return 0 == pending; });
+        }
+        
+    private:
+        Workers(const Workers&);
+        
+        Workers& operator=(const Workers&);
+        
+        void work(VerificationContext* context, std::size_t index)
+        {
+            std::size_t done = 0;
+            std::unique_lock<std::mutex> lock(mutex);
+            
+            while (true)
+            {
+                started.wait(lock, [this, done] { return stop || round != done; });
+                if (stop)
+                {
+                    return;
+                }
+                done = round;
+                
+                lock.unlock();
+                evaluate(&context->model, &context->verifier, &context->cost, points, shortcuts[index]);
+                lock.lock();
+                
+                if (0 == --pending)
+                {
+                    finished.notify_one();
+                }
+            }
+        }
+        
+        const std::vector<rl::math::Vector>& points;
+        std::vector<Shortcut>& shortcuts;
+        std::vector<std::thread> threads;
+        std::mutex mutex;
+        std::condition_variable started;
+        std::condition_variable finished;
+        std::size_t round;
+        std::size_t pending;
+        bool stop;
+    };
+    
+    static void evaluate(PlanningModel* model, rl::plan::Verifier* verifier, const DynamicCost* cost,
+        const std::vector<rl::math::Vector>& points, Shortcut& shortcut)
+    {
+        std::size_t dof = points.front().size();
+        rl::math::Vector a(dof);
+        rl::math::Vector b(dof);
+        model->interpolate(points[shortcut.first], points[shortcut.first + 1], shortcut.alpha1, a);
+        model->interpolate(points[shortcut.last - 1], points[shortcut.last], shortcut.alpha2, b);
+        
+        // Length of the replaced part
+        rl::math::Real length = model->distance(a, points[shortcut.first + 1]) + model->distance(points[shortcut.last - 1], b);
+        for (std::size_t i = shortcut.first + 1; i + 1 < shortcut.last; ++i)
+        {
+            length += model->distance(points[i], points[i + 1]);
+        }
+        
+        if (length <= 0)
+        {
+            return;
+        }
+        
+        shortcut.points.clear();
+        shortcut.points.push_back(a);
+        
+        // Partial shortcut keeps the intermediate vertices, with one joint interpolated by path length
+        if (shortcut.joint >= 0)
+        {
+            rl::math::Real traveled = 0;
+            const rl::math::Vector* previous = &a;
+            
+            for (std::size_t i = shortcut.first + 1; i < shortcut.last; ++i)
+            {
+                traveled += model->distance(*previous, points[i]);
+                previous = &points[i];
+                
+                rl::math::Vector q = points[i];
+                q(shortcut.joint) = a(shortcut.joint) + (b(shortcut.joint) - a(shortcut.joint)) * traveled / length;
+                
+                if (model->constraints.isActive() && !model->project(q))
+                {
+                    return;
+                }
+                
+                shortcut.points.push_back(q);
+            }
+        }
+        
+        shortcut.points.push_back(b);
+        
+        // Compare cost of the replaced part and the shortcut
+        rl::math::Real before = (*cost)(a, points[shortcut.first + 1]) + (*cost)(points[shortcut.last - 1], b);
+        for (std::size_t i = shortcut.first + 1; i + 1 < shortcut.last; ++i)
+        {
+            before += (*cost)(points[i], points[i + 1]);
+        }
+        
+        rl::math::Real after = 0;
+        for (std::size_t i = 1; i < shortcut.points.size(); ++i)
+        {
+            after += (*cost)(shortcut.points[i - 1], shortcut.points[i]);
+        }
+        
+        if (!(after < before - before * std::numeric_limits<rl::math::Real>::epsilon() * 16))
+        {
+            return;
+        }
+        shortcut.gain = before - after;
+        
+        // Endpoints lie on the verified path, check moved vertices and all new segments
+        for (std::size_t i = 1; i < shortcut.points.size(); ++i)
+        {
+            if (i + 1 < shortcut.points.size())
+            {
+                model->setPosition(shortcut.points[i]);
+                model->updateFrames();
+                if (!model->isValid(shortcut.points[i]) || model->isColliding())
+                {
+                    return;
+                }
+            }
+            
+            if (verifier->isColliding(shortcut.points[i - 1], shortcut.points[i], model->distance(shortcut.points[i - 1], shortcut.points[i])))
+            {
+                return;
+            }
+        }
+        
+        shortcut.valid = true;
+    }
+    
+    // Apply valid shortcuts by decreasing gain, skipping those overlapping an applied one
+    static std::size_t apply(std::vector<Shortcut>& shortcuts, std::vector<rl::math::Vector>& points)
+    {
+        std::vector<Shortcut*> selected;
+        
+        std::sort(shortcuts.begin(), shortcuts.end(), [](const Shortcut& lhs, const Shortcut& rhs) { return lhs.gain > rhs.gain; });
+        
+        for (std::size_t i = 0; i < shortcuts.size(); ++i)
+        {
+            if (!shortcuts[i].valid)
+            {
+                continue;
+            }
+            
+            bool overlapping = false;
+            for (std::size_t j = 0; j < selected.size(); ++j)
+            {
+                if (shortcuts[i].last > selected[j]->first && selected[j]->last > shortcuts[i].first)
+                {
+                    overlapping = true;
+                    break;
+                }
+            }
+            
+            if (!overlapping)
+            {
+                selected.push_back(&shortcuts[i]);
+            }
+        }
+        
+        // Splice from the back so that vertex indices of remaining shortcuts stay valid
+        std::sort(selected.begin(), selected.end(), [](const Shortcut* lhs, const Shortcut* rhs) { return lhs->first > rhs->first; });
+        
+        for (std::size_t i = 0; i < selected.size(); ++i)
+        {
+            points.erase(points.begin() + selected[i]->first + 1, points.begin() + selected[i]->last);
+            points.insert(points.begin() + selected[i]->first + 1, selected[i]->points.begin(), selected[i]->points.end());
+        }
+        
+        return selected.size();
+    }
+    
+    std::mt19937 generator;
+};
+
+// Messages below this level are removed at compile time
+#ifndef RLWRAPPER_LOG_MIN_LEVEL
+#define RLWRAPPER_LOG_MIN_LEVEL RL_LOG_LEVEL_INFO
+#endif
+
+// Asynchronous leveled logger. Callers format the message and push it into a bounded
+// lock-free queue (Vyukov MPMC ring); a background thread sleeps on a condition variable
+// until messages are queued and writes them to the sink. A full queue drops the message
+// instead of blocking the caller. The writer drains the queue and stops at exit or when
+// the library is unloaded; later messages are written directly.
+class Logger
+{
+public:
+    static const std::size_t capacity = 4096;
+    
+    // Never destroyed, messages may still be logged during static destruction
+    static Logger& instance()
+    {
+        static Logger* logger = new Logger();
+        return *logger;
+    }
+    
+    bool isEnabled(int level) const
+    {
+        return level >= this->level.load(std::memory_order_relaxed);
+    }
+    
+    void setLevel(int level)
+    {
+        this->level.store(level, std::memory_order_relaxed);
+    }
+    
+    // Callback sink, or stderr if callback is null
+    void setCallback(RL_LogCallback callback, void* userData)
+    {
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        this->callback = callback;
+        this->userData = userData;
+        file.reset();
+    }
+    
+    bool setFile(const char* path)
+    {
+        std::unique_ptr<std::ofstream> stream(new std::ofstream(path, std::ios::out | std::ios::app));
+        if (!*stream)
+        {
+            return false;
+        }
+        
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        callback = nullptr;
+        userData = nullptr;
+        file = std::move(stream);
+        return true;
+    }
+    
+    void write(int level, std::string message)
+    {
+        std::call_once(started, [this]()
+        {
+            writer = std::thread(&Logger::run, this);
+            std::atexit(&Logger::shutdown);
+        });
+        
+        if (stopped.load(std::memory_order_acquire))
+        {
+            emit(level, message);
+            return;
+        }
+        
+        std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        
+        for (;;)
+        {
+            cell = &cells[position & (capacity - 1)];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            
+            if (0 == difference)
+            {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else
+            {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        
+        cell->level = level;
+        cell->message = std::move(message);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        
+        // Pairs with the fence in run(): either the writer sees the message before it
+        // sleeps, or this sees it sleeping and wakes it
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed))
+        {
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+            }
+            wake.notify_one();
+        }
+    }
+    
+    // Wait until all messages queued so far are written
+    void flush()
+    {
+        std::size_t target = enqueuePosition.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        progress.wait(lock, [this, target] { return written.load(std::memory_order_acquire) >= target || finished; });
+    }
+    
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        int level;
+        std::string message;
+    };
+    
+    Logger() :
+        level(RL_LOG_LEVEL_INFO), cells(new Cell[capacity]), enqueuePosition(0), dequeuePosition(0), written(0), dropped(0),
+        started(), writer(), wakeMutex(), wake(), progress(), sleeping(false), stopping(false), finished(false), stopped(false),
+        sinkMutex(), callback(nullptr), userData(nullptr), file()
+    {
+        for (std::size_t i = 0; i < capacity; ++i)
+        {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    
+    // Exit hook: drain the queue and stop the writer; messages after this are written directly
+    static void shutdown()
+    {
+        Logger& logger = instance();
+        
+        {
+            std::unique_lock<std::mutex> lock(logger.wakeMutex);
+            logger.stopping = true;
+            logger.wake.notify_one();
+            logger.progress.wait(lock, [&logger] { return logger.finished; });
+        }
+        logger.stopped.store(true, std::memory_order_release);
+        
+#ifdef _WIN32
+        // Joining would wait for the thread to detach from the DLL, which needs the loader lock held during unload
+        logger.writer.detach();
+#else
+        logger.writer.join();
+#endif
+        
+        // The writer has returned; write messages queued while it was stopping
+        while (logger.isQueued())
+        {
+            logger.writeNext();
+        }
+    }
+    
+    bool isQueued() const
+    {
+        return cells[dequeuePosition & (capacity - 1)].sequence.load(std::memory_order_acquire) == dequeuePosition + 1;
+    }
+    
+    // Background writer, the only consumer of the queue
+    void run()
+    {
+        for (;;)
+        {
+            if (!isQueued())
+            {
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                sleeping.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                wake.wait(lock, [this] { return stopping || isQueued(); });
+                sleeping.store(false, std::memory_order_relaxed);
+                
+                if (!isQueued())
+                {
+                    finished = true;
+                    progress.notify_all();
+                    return;
+                }
+            }
+            
+            writeNext();
+        }
+    }
+    
+    // Dequeue and write the next queued message
+    void writeNext()
+    {
+        Cell& cell = cells[dequeuePosition & (capacity - 1)];
+        
+        int level = cell.level;
+        std::string message = std::move(cell.message);
+        cell.sequence.store(dequeuePosition + capacity, std::memory_order_release);
+        ++dequeuePosition;
+        
+        std::size_t lost = dropped.exchange(0, std::memory_order_relaxed);
+        if (lost > 0)
+        {
+            emit(RL_LOG_LEVEL_WARNING, "Log queue full, dropped " + std::to_string(lost) + " messages");
+        }
+        
+        emit(level, message);
+        
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            written.store(dequeuePosition, std::memory_order_release);
+        }
+        progress.notify_all();
+    }
+    
+    void emit(int level, const std::string& message)
+    {
+        static const char* const names[] = { "debug", "info", "warning", "error" };
+        
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        
+        if (callback)
+        {
+            callback(level, message.c_str(), userData);
+        }
+        else
+        {
+            std::ostream& out = file ? static_cast<std::ostream&>(*file) : std::cerr;
+            out << "[" << names[std::min(std::max(level, 0), 3)] << "] " << message << '\n';
+            out.flush();
+        }
+    }
+    
+    std::atomic<int> level;
+    
+    std::unique_ptr<Cell[]> cells;
+    
+    std::atomic<std::size_t> enqueuePosition;
+    
+    std::size_t dequeuePosition;
+    
+    std::atomic<std::size_t> written;
+    
+    std::atomic<std::size_t> dropped;
+    
+    std::once_flag started;
+    
+    std::thread writer;
+    
+    // Guards stopping and finished; wake signals queued messages or stopping to the writer,
+    // progress signals written messages or the writer's exit to flush and shutdown
+    std::mutex wakeMutex;
+    
+    std::condition_variable wake;
+    
+    std::condition_variable progress;
+    
+    std::atomic<bool> sleeping;
+    
+    bool stopping;
+    
+    bool finished;
+    
+    std::atomic<bool> stopped;
+    
+    std::mutex sinkMutex;
+    
+    RL_LogCallback callback;
+    
+    void* userData;
+    
+    std::unique_ptr<std::ofstream> file;
+};
+
+#define RL_LOG(level, message) \
+    do \
+    { \
+        if ((level) >= RLWRAPPER_LOG_MIN_LEVEL && Logger::instance().isEnabled(level)) \
+        { \
+            std::ostringstream logStream; \
+            logStream << message; \
+            Logger::instance().write((level), logStream.str()); \
+        } \
+    } \
+    while (false)
+
+#define RL_LOG_DEBUG(message) RL_LOG(RL_LOG_LEVEL_DEBUG, message)
+#define RL_LOG_INFO(message) RL_LOG(RL_LOG_LEVEL_INFO, message)
+#define RL_LOG_WARNING(message) RL_LOG(RL_LOG_LEVEL_WARNING, message)
+#define RL_LOG_ERROR(message) RL_LOG(RL_LOG_LEVEL_ERROR, message)
+
+// Log-linear latency histogram in microseconds (HDR-style): values up to 16 have exact
+// buckets, larger values 16 linear sub-buckets per power of two, i.e. at most 6.25%
+// relative error. Bucket upper bounds are inclusive (Prometheus le), so a value equal
+// to a bound counts towards it. Buckets are atomics written by one thread and read by
+// DumpMetrics.
+class LatencyHistogram
+{
+public:
+    static const int subBuckets = 16;
+    
+    static const int maxExponent = 40;
+    
+    static const int bucketCount = subBuckets + (maxExponent - 3) * subBuckets;
+    
+    LatencyHistogram() : count(0), sum(0)
+    {
+        for (int i = 0; i < bucketCount; ++i)
+        {
+            buckets[i].store(0, std::memory_order_relaxed);
+        }
+    }
+    
+    static int bucketIndex(std::uint64_t value)
+    {
+        if (value < static_cast<std::uint64_t>(subBuckets))
+        {
+            return static_cast<int>(value);
+        }
+        
+        int exponent = 4;
+        while (exponent < 63 && (value >> (exponent + 1)) > 0)
+        {
+            ++exponent;
+        }
+        
+        if (exponent > maxExponent)
+        {
+            return bucketCount - 1;
+        }
+        
+        return subBuckets + (exponent - 4) * subBuckets + static_cast<int>((value >> (exponent - 4)) - subBuckets);
+    }
+    
+    // Exclusive lower bound of a bucket, also the inclusive upper bound of the previous bucket
+    static std::uint64_t bucketLowerBound(int index)
+    {
+        if (index < subBuckets)
+        {
+            return static_cast<std::uint64_t>(index);
+        }
+        
+        int exponent = (index - subBuckets) / subBuckets + 4;
+        int sub = (index - subBuckets) % subBuckets;
+        return static_cast<std::uint64_t>(subBuckets + sub) << (exponent - 4);
+    }
+    
+    // Bucket i holds values in (bucketLowerBound(i), bucketLowerBound(i + 1)], bucket 0 also holds 0
+    void record(std::uint64_t value)
+    {
+        buckets[bucketIndex(value > 0 ? value - 1 : 0)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(value, std::memory_order_relaxed);
+    }
+    
+    std::atomic<std::uint64_t> buckets[bucketCount];
+    std::atomic<std::uint64_t> count;
+    std::atomic<std::uint64_t> sum;
+};
+
+// Label values of the recorded metric series
+static const char* const metricPlannerLabels[] = { "rrt", "rrtConCon", "rrtGoalBias", "prm", "other" };
+static const char* const metricResultLabels[] = { "success", "invalid_pointer", "invalid_parameter", "load_failed",
+    "planning_failed", "not_initialized", "exception", "buffer_too_small", "aborted", "other" };
+static const char* const metricValidityLabels[] = { "valid", "invalid" };
+static const char* const metricLoadLabels[] = { "kinematics", "scene", "plan" };
+static const char* const metricCounterNames[] = { "rlwrapper_collision_checks_total", "rlwrapper_samples_total",
+    "rlwrapper_nearest_neighbor_queries_total", "rlwrapper_shortcuts_total" };
+
+// Latency series: plan by planner type and result, validity check by result, load by file type and result
+enum MetricSeries
+{
+    METRIC_PLAN = 0,
+    METRIC_VALIDITY = METRIC_PLAN + 5 * 10,
+    METRIC_LOAD = METRIC_VALIDITY + 2,
+    METRIC_SERIES_COUNT = METRIC_LOAD + 3 * 10
+};
+
+enum MetricCounter
+{
+    METRIC_COLLISION_CHECKS,
+    METRIC_SAMPLES,
+    METRIC_NEAREST_NEIGHBOR_QUERIES,
+    METRIC_SHORTCUTS,
+    METRIC_COUNTER_COUNT
+};
+
+// Metrics written by one thread; histograms are allocated on first use
+struct ThreadMetrics
+{
+    ThreadMetrics() : inUse(true)
+    {
+        for (int i = 0; i < METRIC_SERIES_COUNT; ++i)
+        {
+            histograms[i].store(nullptr, std::memory_order_relaxed);
+        }
+        for (int i = 0; i < METRIC_COUNTER_COUNT; ++i)
+        {
+            counters[i].store(0, std::memory_order_relaxed);
+        }
+    }
+    
+    ~ThreadMetrics()
+    {
+        for (int i = 0; i < METRIC_SERIES_COUNT; ++i)
+        {
+            delete histograms[i].load(std::memory_order_relaxed);
+        }
+    }
+    
+    LatencyHistogram* histogram(int series)
+    {
+        LatencyHistogram* histogram = histograms[series].load(std::memory_order_acquire);
+        if (!histogram)
+        {
+            histogram = new LatencyHistogram();
+            histograms[series].store(histogram, std::memory_order_release);
+        }
+        return histogram;
+    }
+    
+    std::atomic<LatencyHistogram*> histograms[METRIC_SERIES_COUNT];
+    std::atomic<std::uint64_t> counters[METRIC_COUNTER_COUNT];
+    
+    // Cleared when the owning thread exits, the block is then reused by a new thread
+    std::atomic<bool> inUse;
+};
+
+// Process-wide registry of per-thread metrics. Recording only touches the calling
+// thread's block without locks; the mutex guards the block list when a thread
+// records its first value and while DumpMetrics aggregates all blocks.
+class MetricsRegistry
+{
+public:
+    static MetricsRegistry& instance()
+    {
+        static MetricsRegistry registry;
+        return registry;
+    }
+    
+    ThreadMetrics& local()
+    {
+        struct Handle
+        {
+            Handle() : metrics(MetricsRegistry::instance().acquire()) {}
+            ~Handle() { metrics->inUse.store(false, std::memory_order_release); }
+            ThreadMetrics* metrics;
+        };
+        
+        static thread_local Handle handle;
+        return *handle.metrics;
+    }
+    
+    void record(int series, std::chrono::steady_clock::duration duration)
+    {
+        std::int64_t microseconds = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        local().histogram(series)->record(static_cast<std::uint64_t>(std::max<std::int64_t>(0, microseconds)));
+    }
+    
+    void add(int counter, std::uint64_t value)
+    {
+        local().counters[counter].fetch_add(value, std::memory_order_relaxed);
+    }
+    
+    // Prometheus text exposition format
+    std::string dump()
+    {
+        std::vector<std::vector<std::uint64_t>> buckets(METRIC_SERIES_COUNT);
+        std::vector<std::uint64_t> counts(METRIC_SERIES_COUNT, 0);
+        std::vector<std::uint64_t> sums(METRIC_SERIES_COUNT, 0);
+        std::vector<std::uint64_t> counters(METRIC_COUNTER_COUNT, 0);
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            
+            for (std::size_t i = 0; i < blocks.size(); ++i)
+            {
+                for (int series = 0; series < METRIC_SERIES_COUNT; ++series)
+                {
+                    LatencyHistogram* histogram = blocks[i]->histograms[series].load(std::memory_order_acquire);
+                    if (!histogram)
+                    {
+                        continue;
+                    }
+                    
+                    buckets[series].resize(LatencyHistogram::bucketCount, 0);
+                    for (int j = 0; j < LatencyHistogram::bucketCount; ++j)
+                    {
+                        buckets[series][j] += histogram->buckets[j].load(std::memory_order_relaxed);
+                    }
+                    counts[series] += histogram->count.load(std::memory_order_relaxed);
+                    sums[series] += histogram->sum.load(std::memory_order_relaxed);
+                }
+                
+                for (int counter = 0; counter < METRIC_COUNTER_COUNT; ++counter)
+                {
+                    counters[counter] += blocks[i]->counters[counter].load(std::memory_order_relaxed);
+                }
+            }
+        }
+        
+        std::ostringstream out;
+        
+        writeFamily(out, "rlwrapper_plan_duration_seconds", "Latency of planning calls.", buckets, counts, sums, METRIC_PLAN, 5, 10,
+            "planner", metricPlannerLabels, "result", metricResultLabels);
+        writeFamily(out, "rlwrapper_validity_check_duration_seconds", "Latency of configuration validity checks.", buckets, counts, sums, METRIC_VALIDITY, 1, 2,
+            nullptr, nullptr, "result", metricValidityLabels);
+        writeFamily(out, "rlwrapper_load_duration_seconds", "Latency of kinematics, scene and plan loading.", buckets, counts, sums, METRIC_LOAD, 3, 10,
+            "file", metricLoadLabels, "result", metricResultLabels);
+        
+        for (int counter = 0; counter < METRIC_COUNTER_COUNT; ++counter)
+        {
+            out << "# TYPE " << metricCounterNames[counter] << " counter\n";
+            out << metricCounterNames[counter] << " " << counters[counter] << "\n";
+        }
+        
+        return out.str();
+    }
+    
+private:
+    MetricsRegistry() : mutex(), blocks() {}
+    
+    ThreadMetrics* acquire()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        
+        for (std::size_t i = 0; i < blocks.size(); ++i)
+        {
+            bool free = false;
+            if (blocks[i]->inUse.compare_exchange_strong(free, true, std::memory_order_acq_rel))
+            {
+                return blocks[i].get();
+            }
+        }
+        
+        blocks.push_back(std::unique_ptr<ThreadMetrics>(new ThreadMetrics()));
+        return blocks.back().get();
+    }
+    
+    // Histogram with power-of-two bucket bounds (exact, inclusive bucket boundaries) and quantile estimates
+    static void writeFamily(std::ostringstream& out, const char* name, const char* help,
+        const std::vector<std::vector<std::uint64_t>>& buckets, const std::vector<std::uint64_t>& counts,
+        const std::vector<std::uint64_t>& sums, int first, int outerCount, int innerCount,
+        const char* outerLabel, const char* const* outerValues, const char* innerLabel, const char* const* innerValues)
+    {
+        const double quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+        std::ostringstream quantileOut;
+        
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " histogram\n";
+        
+        for (int outer = 0; outer < outerCount; ++outer)
+        {
+            for (int inner = 0; inner < innerCount; ++inner)
+            {
+                int series = first + outer * innerCount + inner;
+                if (0 == counts[series])
+                {
+                    continue;
+                }
+                
+                std::string labels;
+                if (outerLabel)
+                {
+                    labels += std::string(outerLabel) + "=\"" + outerValues[outer] + "\",";
+                }
+                labels += std::string(innerLabel) + "=\"" + innerValues[inner] + "\"";
+                
+                std::uint64_t cumulative = 0;
+                int index = 0;
+                for (int exponent = 4; exponent <= LatencyHistogram::maxExponent; ++exponent)
+                {
+                    int boundIndex = LatencyHistogram::bucketIndex(static_cast<std::uint64_t>(1) << exponent);
+                    for (; index < boundIndex; ++index)
+                    {
+                        cumulative += buckets[series][index];
+                    }
+                    out << name << "_bucket{" << labels << ",le=\"" << static_cast<double>(static_cast<std::uint64_t>(1) << exponent) * 1e-6 << "\"} " << cumulative << "\n";
+                }
+                out << name << "_bucket{" << labels << ",le=\"+Inf\"} " << counts[series] << "\n";
+                out << name << "_sum{" << labels << "} " << static_cast<double>(sums[series]) * 1e-6 << "\n";
+                out << name << "_count{" << labels << "} " << counts[series] << "\n";
+                
+                for (std::size_t q = 0; q < sizeof(quantiles) / sizeof(quantiles[0]); ++q)
+                {
+                    quantileOut << name << "_quantile{" << labels << ",quantile=\"" << quantiles[q] << "\"} "
+                        << estimateQuantile(buckets[series], counts[series], quantiles[q]) * 1e-6 << "\n";
+                }
+            }
+        }
+        
+        if (!quantileOut.str().empty())
+        {
+            out << "# HELP " << name << "_quantile Quantile estimates from the histogram buckets.\n";
+            out << "# TYPE " << name << "_quantile gauge\n";
+            out << quantileOut.str();
+        }
+    }
+    
+    // Midpoint of the bucket containing the quantile
+    static double estimateQuantile(const std::vector<std::uint64_t>& buckets, std::uint64_t count, double quantile)
+    {
+        std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(quantile * count));
+        std::uint64_t cumulative = 0;
+        
+        for (int i = 0; i < LatencyHistogram::bucketCount; ++i)
+        {
+            cumulative += buckets[i];
+            if (cumulative >= rank && buckets[i] > 0)
+            {
+                double lower = static_cast<double>(LatencyHistogram::bucketLowerBound(i));
+                double upper = (i + 1 < LatencyHistogram::bucketCount) ? static_cast<double>(LatencyHistogram::bucketLowerBound(i + 1)) : lower;
+                return 0.5 * (lower + upper);
+            }
+        }
+        
+        return 0;
+    }
+    
+    std::mutex mutex;
+    
+    std::vector<std::unique_ptr<ThreadMetrics>> blocks;
+};
+
+// Helper function to map a planner type name to its metric label index
+static int metricPlannerIndex(const std::string& plannerType)
+{
+    if ("rrt" == plannerType || "RRT" == plannerType)
+    {
+        return 0;
+    }
+    if ("rrtConCon" == plannerType || "RRTConCon" == plannerType || "rrtConnect" == plannerType || "RRTConnect" == plannerType)
+    {
+        return 1;
+    }
+    if ("rrtGoalBias" == plannerType || "RRTGoalBias" == plannerType)
+    {
+        return 2;
+    }
+    if ("prm" == plannerType || "PRM" == plannerType)
+    {
+        return 3;
+    }
+    return 4;
+}
+
+// Helper function to map a result code to its metric label index
+static int metricResultIndex(int result)
+{
+    return (result <= 0 && result >= -8) ? -result : 9;
+}
+
+// Ring buffer of trace events exported as Chrome trace JSON (viewable in Perfetto or chrome://tracing).
+// Writers claim a slot with one atomic increment and publish it through a per-slot sequence number,
+// so recording never blocks; the oldest events are overwritten when the buffer is full.
+class TraceBuffer
+{
+public:
+    static const std::size_t capacity = 65536;
+    
+    static TraceBuffer& instance()
+    {
+        static TraceBuffer buffer;
+        return buffer;
+    }
+    
+    bool isEnabled() const
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+    
+    void setEnabled(bool value)
+    {
+        enabled.store(value, std::memory_order_relaxed);
+    }
+    
+    // name must be a string literal, phase 'B' (begin) or 'E' (end)
+    void record(const char* name, char phase)
+    {
+        static std::atomic<std::uint32_t> nextThreadId(1);
+        static thread_local std::uint32_t threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+        
+        std::int64_t timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - epoch).count();
+        std::uint64_t index = head.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slots[index % capacity];
+        
+        // Odd sequence marks the slot as being written
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.timestamp.store(timestamp, std::memory_order_relaxed);
+        slot.thread.store((threadId << 8) | static_cast<std::uint8_t>(phase), std::memory_order_relaxed);
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+    }
+    
+    // Chrome trace JSON of the events currently in the buffer, oldest first
+    std::string dump() const
+    {
+        std::uint64_t end = head.load(std::memory_order_acquire);
+        std::uint64_t begin = end > capacity ? end - capacity : 0;
+        
+        std::ostringstream out;
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        
+        bool first = true;
+        for (std::uint64_t index = begin; index < end; ++index)
+        {
+            const Slot& slot = slots[index % capacity];
+            
+            std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const char* name = slot.name.load(std::memory_order_relaxed);
+            std::int64_t timestamp = slot.timestamp.load(std::memory_order_relaxed);
+            std::uint32_t thread = slot.thread.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            
+            // Skip slots being written or already overwritten by a newer event
+            if (sequence != 2 * index + 2 || slot.sequence.load(std::memory_order_relaxed) != sequence)
+            {
+                continue;
+            }
+            
+            out << (first ? "" : ",") << "\n{\"name\":\"" << name << "\",\"cat\":\"rlwrapper\",\"ph\":\""
+                << static_cast<char>(thread & 0xFF) << "\",\"ts\":" << timestamp
+                << ",\"pid\":1,\"tid\":" << (thread >> 8) << "}";
+            first = false;
+        }
+        
+        out << "\n]}\n";
+        return out.str();
+    }
+    
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> sequence;
+        std::atomic<const char*> name;
+        std::atomic<std::int64_t> timestamp;
+        std::atomic<std::uint32_t> thread;
+    };
+    
+    TraceBuffer() : enabled(false), head(0), epoch(std::chrono::steady_clock::now()), slots(new Slot[capacity])
+    {
+        for (std::size_t i = 0; i < capacity; ++i)
+        {
+            slots[i].sequence.store(0, std::memory_order_relaxed);
+            slots[i].name.store("", std::memory_order_relaxed);
+            slots[i].timestamp.store(0, std::memory_order_relaxed);
+            slots[i].thread.store(0, std::memory_order_relaxed);
+        }
+    }
+    
+    std::atomic<bool> enabled;
+    
+    std::atomic<std::uint64_t> head;
+    
+    std::chrono::steady_clock::time_point epoch;
+    
+    std::unique_ptr<Slot[]> slots;
+};
+
+// Begin/end trace events of a scope; end() closes the span early, the destructor closes it on any exit
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* name) : name(TraceBuffer::instance().isEnabled() ? name : nullptr)
+    {
+        if (this->name)
+        {
+            TraceBuffer::instance().record(this->name, 'B');
+        }
+    }
+    
+    ~TraceScope()
+    {
+        end();
+    }
+    
+    void end()
+    {
+        if (name)
+        {
+            TraceBuffer::instance().record(name, 'E');
+            name = nullptr;
+        }
+    }
+    
+private:
+    TraceScope(const TraceScope&);
+    
+    TraceScope& operator=(const TraceScope&);
+    
+    const char* name;
+};
+
+// Internal planner state structure
+struct PlannerState
+{
+    std::shared_ptr<rl::sg::Scene> scene;
+    std::shared_ptr<rl::kin::Kinematics> kinematics;
+    std::shared_ptr<rl::mdl::Model> mdl;  // Keep model alive if it's a Dynamic model
+    std::shared_ptr<PlanningModel> model;
+    rl::sg::Model* robotModel;
+    bool initialized;
+    
+    // Files loaded by LoadScene and LoadKinematics, used to load verification contexts
+    std::string scenePath;
+    std::string kinematicsPath;
+    
+    // Collision engine of scenes loaded by LoadScene, empty for the first compiled engine
+    std::string collisionEngine;
+    
+    // Persistent planner components
+    std::shared_ptr<rl::plan::Planner> planner;
+    std::shared_ptr<rl::plan::Sampler> sampler;
+    std::shared_ptr<rl::plan::Verifier> verifier;
+    std::shared_ptr<rl::plan::NearestNeighbors> nearestNeighbors;
+    std::shared_ptr<rl::plan::SimpleOptimizer> optimizer;
+    
+    // Path optimizer ("simple" or "advanced"), time budget and threads of the advanced optimizer
+    std::string optimizerType;
+    int optimizationTimeMs;
+    int optimizerThreads;
+    std::vector<std::shared_ptr<VerificationContext>> verificationContexts;
+    
+    // Stored start/goal configurations
+    std::shared_ptr<rl::math::Vector> start;
+    std::shared_ptr<rl::math::Vector> goal;
+    
+    // Constraints applied by PlanTrajectory
+    PlanningConstraints constraints;
+    
+    // Additional robots of the same scene, each with its own kinematics and planning model
+    std::vector<std::shared_ptr<PlannerState>> robots;
+    
+    // Robot contexts of previously loaded scenes, kept alive so that their handles are rejected
+    std::vector<std::shared_ptr<PlannerState>> retiredRobots;
+    
+    // Planner instance owning this robot context, null for planner instances
+    PlannerState* parent;
+    
+    // Persistent roadmap used in replanning mode, null when disabled
+    std::shared_ptr<IncrementalRoadmap> roadmap;
+    double replanningMargin;
+    
+    // Joint limits for time parameterization and dynamic path cost, read from the kinematics XML
+    JointLimits jointLimits;
+    
+    // Cost minimized by the advanced optimizer and the replanning roadmap
+    DynamicCost::Type costType;
+    
+    // Reachability map for early rejection of unreachable goal poses
+    std::shared_ptr<ReachabilityMap> reachabilityMap;
+    
+    // Planner type and parameters
+    std::string plannerType;
+    double delta;
+    double epsilon;
+    int timeoutMs;
+    
+    // Local planner used by the tree planners to extend towards samples
+    std::string localPlanner;
+    double jacobianDamping;
+    
+    // Hierarchical planning: coarse plan with inflated obstacles, refined at full resolution
+    bool hierarchical;
+    double coarseFactor;
+    double inflationMargin;
+    
+    // Corner blending of optimized paths, disabled if blendRadius is 0
+    double blendRadius;
+    int blendSamples;
+    
+    // Output resampling ("joint", "cartesian") or compression ("compress"), "none" to return the path as planned
+    std::string outputMode;
+    double outputResolution;
+    
+    // Seed for the random sources of the next planning call (sampler, goal bias, shortcut optimizer)
+    std::uint32_t seed;
+    bool seedPending;
+    bool shortcutSeedPending;
+    
+    // Statistics of the last planning call
+    RL_PlanStats stats;
+    
+    PlannerState() : robotModel(nullptr), initialized(false), optimizerType("simple"), optimizationTimeMs(1000), optimizerThreads(0), parent(nullptr),
+        replanningMargin(1.0), costType(DynamicCost::TYPE_LENGTH), delta(0.1), epsilon(0.001), timeoutMs(30000),
+        localPlanner("linear"), jacobianDamping(0.01), hierarchical(false), coarseFactor(4.0), inflationMargin(0.0),
+        blendRadius(0.0), blendSamples(8), outputMode("none"), outputResolution(0.0),
+        seed(0), seedPending(false), shortcutSeedPending(false), stats() {}
+};
+
+// Path returned by a result handle, stored contiguously (count * dof values) until released
+struct PathResult
+{
+    std::vector<double> waypoints;
+    int dof;
+    int count;
+};
+
+// Collision engines compiled into the library, in the order createScene prefers them
+static const char* const collisionEngines[] = {
+#ifdef RL_SG_FCL
+    "fcl",
+#endif
+#ifdef RL_SG_ODE
+    "ode",
+#endif
+#ifdef RL_SG_PQP
+    "pqp",
+#endif
+#ifdef RL_SG_BULLET
+    "bullet",
+#endif
+#ifdef RL_SG_SOLID
+    "solid",
+#endif
+    nullptr
+};
+
+// Helper function to create scene based on available engines
+// engine: name from collisionEngines, empty for the first compiled engine
+static std::shared_ptr<rl::sg::Scene> createScene(const std::string& engine = std::string())
+{
+    std::string name = engine.empty() && collisionEngines[0] ? collisionEngines[0] : engine;
+    
+#ifdef RL_SG_FCL
+    if ("fcl" == name)
+    {
+        return std::make_shared<rl::sg::fcl::Scene>();
+    }
+#endif
+#ifdef RL_SG_ODE
+    if ("ode" == name)
+    {
+        return std::make_shared<rl::sg::ode::Scene>();
+    }
+#endif
+#ifdef RL_SG_PQP
+    if ("pqp" == name)
+    {
+        return std::make_shared<rl::sg::pqp::Scene>();
+    }
+#endif
+#ifdef RL_SG_BULLET
+    if ("bullet" == name)
+    {
+        return std::make_shared<rl::sg::bullet::Scene>();
+    }
+#endif
+#ifdef RL_SG_SOLID
+    if ("solid" == name)
+    {
+        return std::make_shared<rl::sg::solid::Scene>();
+    }
+#endif
+    
+    if (name.empty())
+    {
+        throw std::runtime_error("No collision detection engine available");
+    }
+    
+    throw std::runtime_error("Collision detection engine not available: " + name);
+}
+
+// Helper function to compute the 6D workspace error (translation, rotation vector) between two frames
+static rl::math::Vector workspaceError(const rl::math::Transform& current, const rl::math::Transform& target)
+{
+    rl::math::Vector dx(6);
+    dx.head<3>() = target.translation() - current.translation();
+    rl::math::AngleAxis rotation(target.linear() * current.linear().transpose());
+    dx.tail<3>() = rotation.angle() * rotation.axis();
+    return dx;
+}
+
+// Helper function to read a pose given as x, y, z or x, y, z, qw, qx, qy, qz
+static bool readPose(const double* pose, int poseSize, rl::math::Transform& transform, bool& hasOrientation)
+{
+    if (poseSize != 3 && poseSize != 7)
+    {
+        return false;
+    }
+    
+    transform.setIdentity();
+    transform.translation() = rl::math::Vector3(pose[0], pose[1], pose[2]);
+    hasOrientation = (poseSize == 7);
+    
+    if (hasOrientation)
+    {
+        rl::math::Quaternion orientation(pose[3], pose[4], pose[5], pose[6]);
+        if (orientation.norm() <= std::numeric_limits<rl::math::Real>::epsilon())
+        {
+            return false;
+        }
+        transform.linear() = orientation.normalized().toRotationMatrix();
+    }
+    
+    return true;
+}
+
+// Helper function to solve inverse kinematics with damped Jacobian pseudo-inverse iterations
+// Position-only targets ignore the rotational part of the workspace error
+static bool solveInverseKinematics(rl::plan::Model* model, const rl::math::Transform& target, bool useOrientation,
+    const rl::math::Vector& seed, rl::math::Vector& q)
+{
+    const int maxIterations = 200;
+    const rl::math::Real tolerance = 1.0e-4;
+    
+    q = seed;
+    
+    for (int i = 0; i < maxIterations; ++i)
+    {
+        model->setPosition(q);
+        model->updateFrames(false);
+        
+        rl::math::Vector dx = workspaceError(model->forwardPosition(), target);
+        if (!useOrientation)
+        {
+            dx.tail<3>().setZero();
+        }
+        
+        if (dx.norm() < tolerance)
+        {
+            return model->isValid(q);
+        }
+        
+        model->updateJacobian();
+        model->updateJacobianInverse(0.01, false);
+        
+        rl::math::Vector next(q.size());
+        model->step(q, model->getJacobianInverse() * dx, next);
+        model->clip(next);
+        q = next;
+    }
+    
+    return false;
+}
+
+// Helper function to write reachability map to disk
+static bool saveReachabilityMap(const ReachabilityMap& map, const char* path)
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    
+    const char magic[4] = { 'R', 'L', 'R', 'M' };
+    std::uint32_t version = 2;
+    std::int32_t dof = map.dof;
+    file.write(magic, sizeof(magic));
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(&dof), sizeof(dof));
+    file.write(reinterpret_cast<const char*>(&map.voxelSize), sizeof(map.voxelSize));
+    for (int i = 0; i < 3; ++i)
+    {
+        double origin = map.origin(i);
+        std::int32_t dim = map.dims[i];
+        file.write(reinterpret_cast<const char*>(&origin), sizeof(origin));
+        file.write(reinterpret_cast<const char*>(&dim), sizeof(dim));
+    }
+    file.write(reinterpret_cast<const char*>(map.counts.data()), map.counts.size() * sizeof(std::uint16_t));
+    
+    return static_cast<bool>(file);
+}
+
+// Helper function to read reachability map from disk
+// Rejects files whose header describes more voxels than the file holds
+static std::shared_ptr<ReachabilityMap> loadReachabilityMap(const char* path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        return nullptr;
+    }
+    std::streamoff size = file.tellg();
+    file.seekg(0);
+    
+    char magic[4];
+    std::uint32_t version = 0;
+    std::int32_t dof = 0;
+    std::shared_ptr<ReachabilityMap> map = std::make_shared<ReachabilityMap>();
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&dof), sizeof(dof));
+    file.read(reinterpret_cast<char*>(&map->voxelSize), sizeof(map->voxelSize));
+    if (!file || std::strncmp(magic, "RLRM", 4) != 0 || version != 2 || map->voxelSize <= 0)
+    {
+        return nullptr;
+    }
+    map->dof = dof;
+    
+    for (int i = 0; i < 3; ++i)
+    {
+        double origin = 0;
+        std::int32_t dim = 0;
+        file.read(reinterpret_cast<char*>(&origin), sizeof(origin));
+        file.read(reinterpret_cast<char*>(&dim), sizeof(dim));
+        if (!file || dim <= 0)
+        {
+            return nullptr;
+        }
+        map->origin(i) = origin;
+        map->dims[i] = dim;
+    }
+    
+    // Voxels the rest of the file can hold, checked before each multiplication so the product cannot overflow
+    std::size_t capacity = static_cast<std::size_t>(size - file.tellg()) / (ReachabilityMap::ORIENTATION_BINS * sizeof(std::uint16_t));
+    std::size_t voxels = 1;
+    for (int i = 0; i < 3; ++i)
+    {
+        if (static_cast<std::size_t>(map->dims[i]) > capacity / voxels)
+        {
+            return nullptr;
+        }
+        voxels *= static_cast<std::size_t>(map->dims[i]);
+    }
+    
+    map->counts.resize(voxels * ReachabilityMap::ORIENTATION_BINS);
+    file.read(reinterpret_cast<char*>(map->counts.data()), map->counts.size() * sizeof(std::uint16_t));
+    
+    if (!file)
+    {
+        return nullptr;
+    }
+    
+    return map;
+}
+
+// Helper function to sample path so consecutive configurations are at most resolution apart
+static void densifyPath(rl::plan::Model* model, const rl::plan::VectorList& path, rl::math::Real resolution,
+    std::vector<rl::math::Vector>& samples)
+{
+    samples.clear();
+    
+    for (rl::plan::VectorList::const_iterator i = path.begin(); i != path.end(); ++i)
+    {
+        if (samples.empty())
+        {
+            samples.push_back(*i);
+            continue;
+        }
+        
+        const rl::math::Vector previous = samples.back();
+        int steps = static_cast<int>(std::ceil(model->distance(previous, *i) / resolution));
+        for (int j = 1; j <= steps; ++j)
+        {
+            rl::math::Vector q(i->size());
+            model->interpolate(previous, *i, static_cast<rl::math::Real>(j) / steps, q);
+            samples.push_back(q);
+        }
+    }
+}
+
+// Helper function to subdivide a path so that the tool frame moves at most step between samples
+// Segments are bisected until the step holds or the bisection depth limit is reached
+static void densifyPathCartesian(rl::plan::Model* model, const rl::plan::VectorList& path, rl::math::Real step,
+    std::vector<rl::math::Vector>& samples)
+{
+    const int maxDepth = 16;
+    samples.clear();
+    
+    rl::math::Vector3 previousPosition;
+    
+    for (rl::plan::VectorList::const_iterator i = path.begin(); i != path.end(); ++i)
+    {
+        model->setPosition(*i);
+        model->updateFrames();
+        rl::math::Vector3 position = model->forwardPosition().translation();
+        
+        if (samples.empty())
+        {
+            samples.push_back(*i);
+            previousPosition = position;
+            continue;
+        }
+        
+        // Targets still to reach from the last sample, with the bisection depth of that interval
+        std::vector<std::pair<rl::math::Vector, int>> targets;
+        targets.push_back(std::make_pair(*i, 0));
+        
+        while (!targets.empty())
+        {
+            model->setPosition(targets.back().first);
+            model->updateFrames();
+            position = model->forwardPosition().translation();
+            
+            int depth = targets.back().second;
+            if ((position - previousPosition).norm() > step && depth < maxDepth)
+            {
+                rl::math::Vector middle(i->size());
+                model->interpolate(samples.back(), targets.back().first, 0.5, middle);
+                targets.back().second = depth + 1;
+                targets.push_back(std::make_pair(middle, depth + 1));
+                continue;
+            }
+            
+            samples.push_back(targets.back().first);
+            previousPosition = position;
+            targets.pop_back();
+        }
+    }
+}
+
+// Helper function to remove waypoints within tolerance (joint space) of the simplified path
+// Douglas-Peucker simplification; a waypoint is also kept where the simplified segment collides
+static void compressPath(rl::plan::Model* model, rl::plan::Verifier* verifier, rl::math::Real tolerance, rl::plan::VectorList& path)
+{
+    if (path.size() < 3)
+    {
+        return;
+    }
+    
+    int dof = static_cast<int>(path.front().size());
+    int count = static_cast<int>(path.size());
+    
+    rl::math::Matrix points(dof, count);
+    int column = 0;
+    for (rl::plan::VectorList::const_iterator i = path.begin(); i != path.end(); ++i, ++column)
+    {
+        points.col(column) = *i;
+    }
+    
+    std::vector<bool> keep(count, false);
+    keep.front() = true;
+    keep.back() = true;
+    
+    std::vector<std::pair<int, int>> ranges;
+    ranges.push_back(std::make_pair(0, count - 1));
+    
+    while (!ranges.empty())
+    {
+        int first = ranges.back().first;
+        int last = ranges.back().second;
+        ranges.pop_back();
+        
+        if (last - first < 2)
+        {
+            continue;
+        }
+        
+        // Distances of all interior waypoints to the chord at once
+        rl::math::Vector chord = points.col(last) - points.col(first);
+        rl::math::Real chordSquared = chord.squaredNorm();
+        rl::math::Matrix offsets = points.middleCols(first + 1, last - first - 1).colwise() - points.col(first);
+        rl::math::Vector alpha = rl::math::Vector::Zero(last - first - 1);
+        if (chordSquared > 0)
+        {
+            alpha = ((offsets.transpose() * chord) / chordSquared).cwiseMax(0).cwiseMin(1);
+        }
+        rl::math::Matrix residual = offsets - chord * alpha.transpose();
+        
+        Eigen::Index farthest;
+        rl::math::Real distance = std::sqrt(residual.colwise().squaredNorm().maxCoeff(&farthest));
+        
+        if (distance <= tolerance)
+        {
+            rl::math::Vector u = points.col(first);
+            rl::math::Vector v = points.col(last);
+            if (!verifier->isColliding(u, v, model->distance(u, v)))
+            {
+                continue;
+            }
+        }
+        
+        int split = first + 1 + static_cast<int>(farthest);
+        keep[split] = true;
+        ranges.push_back(std::make_pair(first, split));
+        ranges.push_back(std::make_pair(split, last));
+    }
+    
+    path.clear();
+    for (int i = 0; i < count; ++i)
+    {
+        if (keep[i])
+        {
+            path.push_back(points.col(i));
+        }
+    }
+}
+
+// Helper function to compute length, minimum clearance, joint reversals and estimated duration of a path
+// Clearance is checked at samples at most resolution apart; model frames are changed
+static void evaluatePathMetrics(PlanningModel* model, const JointLimits& limits, rl::math::Real resolution,
+    const double* waypoints, int count, int dof, double* metrics)
+{
+    Eigen::Map<const rl::math::Matrix> points(waypoints, dof, count);
+    
+    metrics[0] = 0;
+    metrics[1] = -1;
+    metrics[2] = 0;
+    metrics[3] = 0;
+    
+    if (count <= 0)
+    {
+        return;
+    }
+    
+    if (count > 1)
+    {
+        rl::math::Matrix steps = points.rightCols(count - 1) - points.leftCols(count - 1);
+        metrics[0] = steps.colwise().norm().sum();
+        
+        // Sign changes of each joint's motion, ignoring joints at rest
+        int reversals = 0;
+        for (int j = 0; j < dof; ++j)
+        {
+            int direction = 0;
+            for (int i = 0; i < count - 1; ++i)
+            {
+                int sign = (steps(j, i) > 0) - (steps(j, i) < 0);
+                if (sign != 0)
+                {
+                    if (direction != 0 && sign != direction)
+                    {
+                        ++reversals;
+                    }
+                    direction = sign;
+                }
+            }
+        }
+        metrics[2] = reversals;
+    }
+    
+    rl::plan::VectorList path;
+    for (int i = 0; i < count; ++i)
+    {
+        path.push_back(points.col(i));
+    }
+    
+    std::vector<rl::math::Vector> samples;
+    densifyPath(model, path, resolution, samples);
+    
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+        model->setPosition(samples[i]);
+        model->updateFrames();
+        rl::math::Real clearance = model->getClearance();
+        if (clearance < 0)
+        {
+            break;
+        }
+        metrics[1] = (metrics[1] < 0) ? clearance : std::min(metrics[1], clearance);
+    }
+    
+    if (count > 1)
+    {
+        TimeOptimalParameterization parameterization;
+        std::vector<rl::math::Vector> vertices(path.begin(), path.end());
+        metrics[3] = parameterization.process(vertices, limits) ? parameterization.getDuration() : -1;
+    }
+}
+
+// Helper function to schedule a robot path against time-indexed reservations of higher-priority robots
+// Robot may wait or advance one sample per time step; returns path sample index per time step
+static bool scheduleRobot(
+    PlannerState* robot, const std::vector<rl::math::Vector>& samples,
+    const std::vector<PlannerState*>& reserved, const std::vector<std::vector<rl::math::Vector>>& reservations,
+    std::chrono::steady_clock::time_point deadline, std::vector<std::size_t>& schedule)
+{
+    std::size_t last = samples.size() - 1;
+    std::size_t reservedEnd = 0;
+    for (std::size_t s = 0; s < reservations.size(); ++s)
+    {
+        reservedEnd = std::max(reservedEnd, reservations[s].size() - 1);
+    }
+    std::size_t horizon = reservedEnd + samples.size();
+    
+    // Move of each layer: 0 unreachable, 1 waited, 2 advanced
+    std::vector<std::vector<char>> moves;
+    
+    for (std::size_t t = 0; t <= horizon; ++t)
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        
+        for (std::size_t s = 0; s < reserved.size(); ++s)
+        {
+            const std::vector<rl::math::Vector>& reservation = reservations[s];
+            reserved[s]->model->setPosition(reservation[std::min(t, reservation.size() - 1)]);
+            reserved[s]->model->updateFrames();
+        }
+        
+        std::vector<char> layer(samples.size(), 0);
+        bool any = false;
+        
+        for (std::size_t i = 0; i < samples.size(); ++i)
+        {
+            char move = 0;
+            if (t == 0)
+            {
+                move = (i == 0) ? 1 : 0;
+            }
+            else if (moves[t - 1][i] != 0)
+            {
+                move = 1;
+            }
+            else if (i > 0 && moves[t - 1][i - 1] != 0)
+            {
+                move = 2;
+            }
+            
+            if (move != 0)
+            {
+                robot->model->setPosition(samples[i]);
+                robot->model->updateFrames();
+                if (!robot->model->isColliding())
+                {
+                    layer[i] = move;
+                    any = true;
+                }
+            }
+        }
+        
+        moves.push_back(layer);
+        
+        if (!any)
+        {
+            return false;
+        }
+        
+        // Goal reached once all higher-priority robots are parked
+        if (t >= reservedEnd && layer[last] != 0)
+        {
+            schedule.assign(t + 1, 0);
+            std::size_t i = last;
+            for (std::size_t k = t; k > 0; --k)
+            {
+                schedule[k] = i;
+                if (moves[k][i] == 2)
+                {
+                    --i;
+                }
+            }
+            schedule[0] = i;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+// Helper function to place the other robots of a shared scene at their stored start configurations
+static void parkOtherRobots(PlannerState* state)
+{
+    PlannerState* root = state->parent ? state->parent : state;
+    
+    std::vector<PlannerState*> robots(1, root);
+    for (std::size_t i = 0; i < root->robots.size(); ++i)
+    {
+        robots.push_back(root->robots[i].get());
+    }
+    
+    for (std::size_t i = 0; i < robots.size(); ++i)
+    {
+        if (robots[i] != state && robots[i]->model && robots[i]->start)
+        {
+            robots[i]->model->setPosition(*robots[i]->start);
+            robots[i]->model->updateFrames();
+        }
+    }
+}
+
+// Helper function to read a flat waypoint buffer
+static void readWaypoints(const double* waypoints, int waypointCount, int dof, std::vector<rl::math::Vector>& result)
+{
+    result.clear();
+    result.reserve(waypointCount);
+    for (int i = 0; i < waypointCount; ++i)
+    {
+        result.push_back(Eigen::Map<const rl::math::Vector>(waypoints + i * dof, dof));
+    }
+}
+
+// Helper function to create the path cost of a planner instance for a planning model
+static DynamicCost createDynamicCost(PlannerState* state, PlanningModel* model)
+{
+    DynamicCost cost;
+    cost.type = state->costType;
+    cost.model = model;
+    cost.dynamic = dynamic_cast<rl::mdl::Dynamic*>(model->mdl);
+    cost.speed = state->jointLimits.velocity;
+    cost.torque = state->jointLimits.torque;
+    return cost;
+}
+
+// Helper function to copy body poses of a scene to a copy loaded from the same file
+static void synchronizeScene(rl::sg::Scene* source, rl::sg::Scene* target)
+{
+    for (std::size_t i = 0; i < source->getNumModels() && i < target->getNumModels(); ++i)
+    {
+        rl::sg::Model* sourceModel = source->getModel(i);
+        rl::sg::Model* targetModel = target->getModel(i);
+        
+        for (std::size_t j = 0; j < sourceModel->getNumBodies() && j < targetModel->getNumBodies(); ++j)
+        {
+            rl::math::Transform frame;
+            sourceModel->getBody(j)->getFrame(frame);
+            targetModel->getBody(j)->setFrame(frame);
+        }
+    }
+}
+
+// Helper function to load a private copy of the scene and kinematics of a planner instance or robot context
+static std::shared_ptr<VerificationContext> createVerificationContext(PlannerState* state)
+{
+    PlannerState* root = state->parent ? state->parent : state;
+    if (root->scenePath.empty() || state->kinematicsPath.empty())
+    {
+        return nullptr;
+    }
+    
+    int robotModelIndex = -1;
+    for (std::size_t i = 0; i < state->scene->getNumModels(); ++i)
+    {
+        if (state->scene->getModel(i) == state->robotModel)
+        {
+            robotModelIndex = static_cast<int>(i);
+        }
+    }
+    if (robotModelIndex < 0)
+    {
+        return nullptr;
+    }
+    
+    std::shared_ptr<VerificationContext> context = std::make_shared<VerificationContext>();
+    context->scene = createScene(root->collisionEngine);
+    context->scene->load(root->scenePath);
+    
+    if (state->model->mdl)
+    {
+        rl::mdl::XmlFactory factory;
+        context->mdl = factory.create(state->kinematicsPath);
+        context->model.mdl = dynamic_cast<rl::mdl::Dynamic*>(context->mdl.get());
+    }
+    else
+    {
+        context->kinematics = std::shared_ptr<rl::kin::Kinematics>(rl::kin::Kinematics::create(state->kinematicsPath));
+        context->model.kin = context->kinematics.get();
+    }
+    
+    context->model.model = context->scene->getModel(robotModelIndex);
+    context->model.scene = context->scene.get();
+    context->verifier.model = &context->model;
+    
+    return context;
+}
+
+// Helper function to get up to count verification contexts synchronized with the planning model
+// Contexts are loaded on first use and reused until the scene or kinematics change
+static std::vector<VerificationContext*> acquireVerificationContexts(PlannerState* state, int count)
+{
+    try
+    {
+        while (static_cast<int>(state->verificationContexts.size()) < count)
+        {
+            std::shared_ptr<VerificationContext> context = createVerificationContext(state);
+            if (!context)
+            {
+                break;
+            }
+            state->verificationContexts.push_back(context);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        RL_LOG_WARNING("Could not load verification contexts, continuing sequentially: " << e.what());
+        state->verificationContexts.clear();
+    }
+    
+    std::vector<VerificationContext*> contexts;
+    
+    for (int i = 0; i < count && i < static_cast<int>(state->verificationContexts.size()); ++i)
+    {
+        VerificationContext* context = state->verificationContexts[i].get();
+        synchronizeScene(state->scene.get(), context->scene.get());
+        context->model.constraints = state->model->constraints;
+        context->model.clearanceMargin = state->model->clearanceMargin;
+        context->verifier.delta = state->verifier ? state->verifier->delta : state->delta;
+        context->cost = createDynamicCost(state, &context->model);
+        context->model.collisionChecks = 0;
+        contexts.push_back(context);
+    }
+    
+    return contexts;
+}
+
+// Helper function to run the shortcut optimizer with one verification context per thread
+static std::size_t optimizeParallel(PlannerState* state, rl::plan::VectorList& path)
+{
+    int threadCount = state->optimizerThreads > 0 ? state->optimizerThreads : static_cast<int>(std::thread::hardware_concurrency());
+    
+    ParallelShortcutOptimizer optimizer;
+    optimizer.model = state->model.get();
+    optimizer.verifier = state->verifier.get();
+    optimizer.duration = std::chrono::milliseconds(state->optimizationTimeMs);
+    optimizer.cost = createDynamicCost(state, state->model.get());
+    
+    if (state->shortcutSeedPending)
+    {
+        optimizer.seed(state->seed);
+        state->shortcutSeedPending = false;
+    }
+    
+    if (threadCount > 1)
+    {
+        optimizer.contexts = acquireVerificationContexts(state, threadCount);
+    }
+    
+    optimizer.process(path);
+    
+    return optimizer.applied;
+}
+
+// Tree planner whose extend and connect steps steer the tool frame towards a workspace
+// pose using the damped Jacobian pseudo-inverse. Connect steps steer towards the pose of
+// the configuration being connected to; extend steps towards the pose of the sample or,
+// for a goalPoseBias fraction of them, towards the tool pose at the root of the other
+// tree (the goal pose for the tree grown from the start), so tool-constrained goals pull
+// the search towards them. Falls back to the straight joint-space steps of the base
+// planner when the Jacobian step is not available or does not reduce the workspace error.
+template<typename TreePlanner>
+class JacobianGuidedPlanner : public TreePlanner
+{
+public:
+    JacobianGuidedPlanner() : TreePlanner(), damping(0.01), goalPoseBias(0.1), biasCredit(0) {}
+    
+    rl::math::Real damping;
+    
+    // Fraction of extend steps that target the goal pose, taken at regular intervals
+    rl::math::Real goalPoseBias;
+    
+    bool solve() override
+    {
+        this->biasCredit = 0;
+        return TreePlanner::solve();
+    }
+    
+protected:
+    typedef typename TreePlanner::Neighbor Neighbor;
+    typedef typename TreePlanner::Tree Tree;
+    typedef typename TreePlanner::Vertex Vertex;
+    
+    Vertex extend(Tree& tree, const Neighbor& nearest, const rl::math::Vector& chosen) override
+    {
+        const rl::math::Vector& from = *tree[nearest.first].q;
+        
+        // Close enough for a straight step to reach the sample
+        if (this->model->distance(from, chosen) <= this->delta || this->model->getOperationalDof() != 1)
+        {
+            return TreePlanner::extend(tree, nearest, chosen);
+        }
+        
+        // Workspace target is the goal pose at regular intervals, otherwise the tool frame of the sample
+        const rl::math::Vector* towards = &chosen;
+        this->biasCredit += this->goalPoseBias;
+        if (this->biasCredit >= 1)
+        {
+            this->biasCredit -= 1;
+            towards = (&tree == &this->tree[0]) ? this->goal : this->start;
+        }
+        
+        rl::plan::VectorPtr next = std::make_shared<rl::math::Vector>(this->model->getDofPosition());
+        if (!this->guidedStep(from, this->toolPose(*towards), *next))
+        {
+            return TreePlanner::extend(tree, nearest, chosen);
+        }
+        
+        if (this->model->isColliding())
+        {
+            return nullptr;
+        }
+        
+        Vertex extended = this->addVertex(tree, next);
+        this->addEdge(nearest.first, extended, tree);
+        return extended;
+    }
+    
+    Vertex connect(Tree& tree, const Neighbor& nearest, const rl::math::Vector& chosen) override
+    {
+        if (this->model->getOperationalDof() != 1)
+        {
+            return TreePlanner::connect(tree, nearest, chosen);
+        }
+        
+        rl::math::Transform target = this->toolPose(chosen);
+        Neighbor current = nearest;
+        Vertex connected = nullptr;
+        
+        // Guided steps while they make progress in task space, the rest in a straight line
+        while (current.second > this->delta)
+        {
+            rl::plan::VectorPtr next = std::make_shared<rl::math::Vector>(this->model->getDofPosition());
+            if (!this->guidedStep(*tree[current.first].q, target, *next))
+            {
+                break;
+            }
+            
+            if (this->model->isColliding())
+            {
+                return connected;
+            }
+            
+            connected = this->addVertex(tree, next);
+            this->addEdge(current.first, connected, tree);
+            current = Neighbor(connected, this->model->distance(*next, chosen));
+        }
+        
+        Vertex straight = TreePlanner::connect(tree, current, chosen);
+        return straight ? straight : connected;
+    }
+    
+private:
+    // Tool frame of a configuration
+    rl::math::Transform toolPose(const rl::math::Vector& q)
+    {
+        this->model->setPosition(q);
+        this->model->updateFrames(false);
+        return this->model->forwardPosition();
+    }
+    
+    // One Jacobian step of length delta from q towards target, leaving the model at the result
+    // Returns false if the step is not available, leaves the joint limits or does not reduce the workspace error
+    bool guidedStep(const rl::math::Vector& q, const rl::math::Transform& target, rl::math::Vector& next)
+    {
+        this->model->setPosition(q);
+        this->model->updateFrames(false);
+        this->model->updateJacobian();
+        this->model->updateJacobianInverse(this->damping, false);
+        
+        rl::math::Vector dx = workspaceError(this->model->forwardPosition(), target);
+        rl::math::Vector qdot = this->model->getJacobianInverse() * dx;
+        rl::math::Real norm = qdot.norm();
+        
+        if (!(norm > std::numeric_limits<rl::math::Real>::epsilon()) || this->model->isSingular())
+        {
+            return false;
+        }
+        
+        this->model->step(q, qdot * (this->delta / norm), next);
+        
+        if (!this->model->isValid(next))
+        {
+            return false;
+        }
+        
+        this->model->setPosition(next);
+        this->model->updateFrames();
+        
+        // Only accept the step if it made progress in task space
+        return workspaceError(this->model->forwardPosition(), target).norm() < dx.norm();
+    }
+    
+    rl::math::Real biasCredit;
+};
+
+// Helper function to create a tree planner with the requested local planner
+template<typename TreePlanner>
+static std::shared_ptr<TreePlanner> createTreePlanner(const std::string& localPlanner, double jacobianDamping)
+{
+    if (localPlanner == "jacobian" || localPlanner == "Jacobian")
+    {
+        std::shared_ptr<JacobianGuidedPlanner<TreePlanner>> guided = std::make_shared<JacobianGuidedPlanner<TreePlanner>>();
+        guided->damping = jacobianDamping;
+        return guided;
+    }
+    
+    return std::make_shared<TreePlanner>();
+}
+
+extern "C" {
+
+RL_PLANNER_API void* CreatePlanner()
+{
+    try
+    {
+        PlannerState* state = new PlannerState();
+        return static_cast<void*>(state);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+// Helper function to set joint limits from the per-DOF speed limits of the loaded kinematics or
+// dynamic model (speed element of each joint, rad/s or m/s). Neither format has acceleration, jerk
+// or torque limits: accelerations default to twice the speed, jerk and torque are unlimited until
+// set by SetJointLimits and SetPathCost; joints without a positive speed default to 1
+static void loadJointLimits(PlannerState* state)
+{
+    rl::math::Vector speed;
+    if (state->mdl)
+    {
+        speed = state->mdl->getSpeed();
+    }
+    else if (state->kinematics)
+    {
+        speed.resize(state->kinematics->getDof());
+        state->kinematics->getSpeed(speed);
+    }
+    
+    state->jointLimits = JointLimits();
+    state->jointLimits.velocity = speed;
+    state->jointLimits.acceleration = rl::math::Vector::Zero(speed.size());
+    state->jointLimits.jerk = rl::math::Vector::Zero(speed.size());
+    state->jointLimits.torque = rl::math::Vector::Zero(speed.size());
+    
+    for (int i = 0; i < speed.size(); ++i)
+    {
+        if (!(state->jointLimits.velocity(i) > 0))
+        {
+            RL_LOG_WARNING("LoadKinematics: Joint " << i << " has no positive speed limit, using default 1");
+            state->jointLimits.velocity(i) = 1.0;
+        }
+        
+        state->jointLimits.acceleration(i) = 2.0 * state->jointLimits.velocity(i);
+    }
+    
+    RL_LOG_DEBUG("LoadKinematics: Acceleration limits are twice the speed, jerk and torque are unlimited");
+}
+
+static int loadKinematics(void* planner, const char* xmlPath)
+{
+    if (!planner || !xmlPath)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        // Robot contexts share the scene and kinematics of their planner instance
+        if (state->parent)
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        // Verification contexts refer to the previous kinematics
+        state->kinematicsPath = xmlPath;
+        state->verificationContexts.clear();
+        
+        // Try to load as Dynamic model first
+        try
+        {
+            rl::mdl::XmlFactory factory;
+            std::shared_ptr<rl::mdl::Model> mdl = factory.create(xmlPath);
+            
+            if (std::dynamic_pointer_cast<rl::mdl::Dynamic>(mdl))
+            {
+                // Dynamic model - the planning model uses it for kinematics and dynamics
+                state->mdl = mdl;  // Keep the model alive
+                state->kinematics.reset();
+                loadJointLimits(state);
+                return RL_SUCCESS;
+            }
+        }
+        catch (const std::exception&)
+        {
+            // Not a Dynamic model file, try loading as Kinematics directly
+            // This is expected for kinematics-only XML files
+        }
+        
+        // Load as Kinematics directly (fallback if not a Dynamic model)
+        state->mdl.reset();
+        state->kinematics = std::shared_ptr<rl::kin::Kinematics>(
+            rl::kin::Kinematics::create(xmlPath)
+        );
+        
+        loadJointLimits(state);
+        
+        return RL_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        RL_LOG_ERROR("LoadKinematics exception: " << e.what() << " for file: " << xmlPath);
+        return RL_ERROR_LOAD_FAILED;
+    }
+    catch (...)
+    {
+        RL_LOG_ERROR("LoadKinematics unknown exception for file: " << xmlPath);
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int LoadKinematics(void* planner, const char* xmlPath)
+{
+    TraceScope trace("LoadKinematics");
+    std::chrono::steady_clock::time_point callStart = std::chrono::steady_clock::now();
+    int result = loadKinematics(planner, xmlPath);
+    MetricsRegistry::instance().record(METRIC_LOAD + metricResultIndex(result), std::chrono::steady_clock::now() - callStart);
+    return result;
+}
+
+// Helper function to bind a robot model of the loaded scene to the planning model
+static int bindRobotModel(PlannerState* state, int robotModelIndex)
+{
+    // Get robot model from scene
+    int numModels = static_cast<int>(state->scene->getNumModels());
+    if (robotModelIndex < 0 || robotModelIndex >= numModels)
+    {
+        RL_LOG_ERROR("LoadScene: Invalid robotModelIndex " << robotModelIndex << " (valid range: 0 to " << (numModels - 1) << ")");
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    state->robotModel = state->scene->getModel(robotModelIndex);
+    
+    // Create planning model based on scene type
+    if (rl::sg::DistanceScene* distanceScene = dynamic_cast<rl::sg::DistanceScene*>(state->scene.get()))
+    {
+        // DistanceScene not typically used for planning, fall back to SimpleModel
+        state->model = std::make_shared<PlanningModel>();
+    }
+    else if (rl::sg::SimpleScene* simpleScene = dynamic_cast<rl::sg::SimpleScene*>(state->scene.get()))
+    {
+        state->model = std::make_shared<PlanningModel>();
+    }
+    else
+    {
+        return RL_ERROR_LOAD_FAILED;
+    }
+    
+    // Connect kinematics or dynamic model to model if loaded
+    if (rl::mdl::Dynamic* dynamic = dynamic_cast<rl::mdl::Dynamic*>(state->mdl.get()))
+    {
+        state->model->mdl = dynamic;
+        RL_LOG_DEBUG("LoadScene: Connected Dynamic model to planning model");
+    }
+    else if (state->kinematics)
+    {
+        state->model->kin = state->kinematics.get();
+        RL_LOG_DEBUG("LoadScene: Connected Kinematics to planning model");
+    }
+    else
+    {
+        RL_LOG_WARNING("LoadScene: WARNING - No kinematics loaded, model may not work correctly");
+    }
+    
+    // Connect model to scene
+    state->model->model = state->robotModel;
+    state->model->scene = state->scene.get();
+    
+    // Verify model is properly set up
+    if (!state->model->kin && !state->model->mdl)
+    {
+        RL_LOG_ERROR("LoadScene: ERROR - Model has no kinematics or dynamic model set");
+        return RL_ERROR_NOT_INITIALIZED;
+    }
+    
+    if (!state->model->model || !state->model->scene)
+    {
+        RL_LOG_ERROR("LoadScene: ERROR - Model has no robot model or scene set");
+        return RL_ERROR_NOT_INITIALIZED;
+    }
+    
+    RL_LOG_DEBUG("LoadScene: Model DOF: " << state->model->getDofPosition());
+    
+    state->initialized = true;
+    
+    return RL_SUCCESS;
+}
+
+// Helper function to detach the robot contexts of a planner instance from its scene
+// Handles returned by GetRobotPlanner stay valid but are no longer initialized, so calls on them fail
+static void retireRobots(PlannerState* state)
+{
+    for (std::size_t i = 0; i < state->robots.size(); ++i)
+    {
+        PlannerState* robot = state->robots[i].get();
+        robot->initialized = false;
+        robot->roadmap.reset();
+        robot->verificationContexts.clear();
+        robot->model.reset();
+        robot->robotModel = nullptr;
+        robot->scene.reset();
+        state->retiredRobots.push_back(state->robots[i]);
+    }
+    
+    state->robots.clear();
+}
+
+static int loadScene(void* planner, const char* xmlPath, int robotModelIndex)
+{
+    if (!planner || !xmlPath)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        // Robot contexts share the scene and kinematics of their planner instance
+        if (state->parent)
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        // Roadmap refers to the previous scene and model
+        if (state->roadmap)
+        {
+            state->roadmap->clear();
+        }
+        
+        // Additional robots refer to the previous scene
+        retireRobots(state);
+        
+        // Create scene
+        state->scene = createScene(state->collisionEngine);
+        
+        // Load scene from XML file
+        state->scene->load(xmlPath);
+        state->scenePath = xmlPath;
+        state->verificationContexts.clear();
+        
+        int numModels = static_cast<int>(state->scene->getNumModels());
+        RL_LOG_DEBUG("LoadScene: Loaded scene with " << numModels << " models, requested index: " << robotModelIndex);
+        
+        return bindRobotModel(state, robotModelIndex);
+    }
+    catch (const std::exception& e)
+    {
+        RL_LOG_ERROR("LoadScene exception: " << e.what() << " for file: " << xmlPath);
+        return RL_ERROR_LOAD_FAILED;
+    }
+    catch (...)
+    {
+        RL_LOG_ERROR("LoadScene unknown exception for file: " << xmlPath);
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int LoadScene(void* planner, const char* xmlPath, int robotModelIndex)
+{
+    TraceScope trace("LoadScene");
+    std::chrono::steady_clock::time_point callStart = std::chrono::steady_clock::now();
+    int result = loadScene(planner, xmlPath, robotModelIndex);
+    MetricsRegistry::instance().record(METRIC_LOAD + 10 + metricResultIndex(result), std::chrono::steady_clock::now() - callStart);
+    return result;
+}
+
+// Helper function to create planner based on type
+static std::shared_ptr<rl::plan::Planner> createPlanner(
+    const std::string& plannerType,
+    std::shared_ptr<rl::plan::Sampler> sampler,
+    std::shared_ptr<rl::plan::Verifier> verifier,
+    std::shared_ptr<rl::plan::NearestNeighbors> nearestNeighbors,
+    double delta,
+    double epsilon,
+    const std::string& localPlanner = "linear",
+    double jacobianDamping = 0.01)
+{
+    std::shared_ptr<rl::plan::Planner> planner;
+    
+    if (plannerType == "rrt" || plannerType == "RRT")
+    {
+        std::shared_ptr<rl::plan::Rrt> rrt = createTreePlanner<rl::plan::Rrt>(localPlanner, jacobianDamping);
+        rrt->delta = delta;
+        rrt->epsilon = epsilon;
+        rrt->sampler = sampler.get();
+        rrt->setNearestNeighbors(nearestNeighbors.get(), 0);
+        planner = rrt;
+    }
+    else if (plannerType == "rrtConnect" || plannerType == "RRTConnect" || 
+             plannerType == "rrtConCon" || plannerType == "RRTConCon")
+    {
+        std::shared_ptr<rl::plan::RrtConCon> rrtConCon = createTreePlanner<rl::plan::RrtConCon>(localPlanner, jacobianDamping);
+        rrtConCon->delta = delta;
+        rrtConCon->epsilon = epsilon;
+        rrtConCon->sampler = sampler.get();
+        rrtConCon->setNearestNeighbors(nearestNeighbors.get(), 0);
+        planner = rrtConCon;
+    }
+    else if (plannerType == "rrtGoalBias" || plannerType == "RRTGoalBias")
+    {
+        std::shared_ptr<rl::plan::RrtGoalBias> rrtGoalBias = createTreePlanner<rl::plan::RrtGoalBias>(localPlanner, jacobianDamping);
+        rrtGoalBias->delta = delta;
+        rrtGoalBias->epsilon = epsilon;
+        rrtGoalBias->probability = 0.05;
+        rrtGoalBias->sampler = sampler.get();
+        rrtGoalBias->setNearestNeighbors(nearestNeighbors.get(), 0);
+        planner = rrtGoalBias;
+    }
+    else if (plannerType == "prm" || plannerType == "PRM")
+    {
+        std::shared_ptr<rl::plan::Prm> prm = std::make_shared<rl::plan::Prm>();
+        prm->degree = std::numeric_limits<std::size_t>::max();
+        prm->k = 30;
+        prm->radius = std::numeric_limits<rl::math::Real>::max();
+        prm->sampler = sampler.get();
+        prm->verifier = verifier.get();
+        prm->setNearestNeighbors(nearestNeighbors.get());
+        planner = prm;
+    }
+    
+    return planner;
+}
+
+static int loadPlanXml(void* planner, const char* xmlPath)
+{
+    if (!planner || !xmlPath)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        // Robot contexts share the scene and kinematics of their planner instance
+        if (state->parent)
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        // Parse XML file
+        rl::xml::DomParser parser;
+        rl::xml::Document document = parser.readFile(xmlPath, "", XML_PARSE_NOENT | XML_PARSE_XINCLUDE);
+        document.substitute(XML_PARSE_NOENT | XML_PARSE_XINCLUDE);
+        
+        // Handle XSLT stylesheets if present (like rlPlanDemo)
+        if ("stylesheet" == document.getRootElement().getName() || "transform" == document.getRootElement().getName())
+        {
+            if ("1.0" == document.getRootElement().getProperty("version"))
+            {
+                if (document.getRootElement().hasNamespace() && 
+                    "http://www.w3.org/1999/XSL/Transform" == document.getRootElement().getNamespace().getHref())
+                {
+                    rl::xml::Stylesheet stylesheet(document);
+                    document = stylesheet.apply();
+                }
+            }
+        }
+        
+        rl::xml::Path path(document);
+        
+        // Extract scene file path
+        rl::xml::NodeSet modelScene = path.eval("(/rl/plan|/rlplan)//model/scene").getValue<rl::xml::NodeSet>();
+        if (modelScene.empty())
+        {
+            RL_LOG_ERROR("LoadPlanXml: No scene element found in XML");
+            return RL_ERROR_LOAD_FAILED;
+        }
+        std::string modelSceneFilename = modelScene[0].getLocalPath(modelScene[0].getProperty("href"));
+        
+        // Extract kinematics file path
+        rl::xml::NodeSet modelKinematics = path.eval("(/rl/plan|/rlplan)//model/kinematics").getValue<rl::xml::NodeSet>();
+        if (modelKinematics.empty())
+        {
+            RL_LOG_ERROR("LoadPlanXml: No kinematics element found in XML");
+            return RL_ERROR_LOAD_FAILED;
+        }
+        std::string modelKinematicsFilename = modelKinematics[0].getLocalPath(modelKinematics[0].getProperty("href"));
+        
+        // Extract robot model index
+        std::size_t robotModelIndex = path.eval("number((/rl/plan|/rlplan)//model/model)").getValue<std::size_t>(0);
+        
+        // Extract planner type from root element
+        std::string plannerTypeStr = document.getRootElement().getName();
+        if (plannerTypeStr == "rlplan" || plannerTypeStr == "plan")
+        {
+            // Get planner type from child elements
+            rl::xml::NodeSet planners = path.eval("(/rl/plan|/rlplan)//rrtConCon|(/rl/plan|/rlplan)//rrt|(/rl/plan|/rlplan)//rrtGoalBias|(/rl/plan|/rlplan)//prm").getValue<rl::xml::NodeSet>();
+            if (!planners.empty())
+            {
+                plannerTypeStr = planners[0].getName();
+            }
+            else
+            {
+                plannerTypeStr = "rrtConCon"; // Default
+            }
+        }
+        
+        // Extract planner parameters
+        double delta = 1.0;
+        double epsilon = 0.001;
+        int timeoutMs = 120000; // Default 120 seconds
+        
+        if (path.eval("count((/rl/plan|/rlplan)//delta) > 0").getValue<bool>())
+        {
+            delta = path.eval("number((/rl/plan|/rlplan)//delta)").getValue<double>(delta);
+            std::string unit = path.eval("string((/rl/plan|/rlplan)//delta/@unit)").getValue<std::string>();
+            if (unit == "deg")
+            {
+                delta *= rl::math::constants::deg2rad;
+            }
+        }
+        
+        if (path.eval("count((/rl/plan|/rlplan)//epsilon) > 0").getValue<bool>())
+        {
+            epsilon = path.eval("number((/rl/plan|/rlplan)//epsilon)").getValue<double>(epsilon);
+            std::string unit = path.eval("string((/rl/plan|/rlplan)//epsilon/@unit)").getValue<std::string>();
+            if (unit == "deg")
+            {
+                epsilon *= rl::math::constants::deg2rad;
+            }
+        }
+        
+        if (path.eval("count((/rl/plan|/rlplan)//duration) > 0").getValue<bool>())
+        {
+            timeoutMs = static_cast<int>(path.eval("number((/rl/plan|/rlplan)//duration)").getValue<double>(timeoutMs) * 1000.0);
+        }
+        
+        // Store planner parameters
+        state->plannerType = plannerTypeStr;
+        state->delta = delta;
+        state->epsilon = epsilon;
+        state->timeoutMs = timeoutMs;
+        
+        // Load kinematics
+        int result = LoadKinematics(planner, modelKinematicsFilename.c_str());
+        if (result != RL_SUCCESS)
+        {
+            return result;
+        }
+        
+        // Load scene
+        result = LoadScene(planner, modelSceneFilename.c_str(), static_cast<int>(robotModelIndex));
+        if (result != RL_SUCCESS)
+        {
+            return result;
+        }
+        
+        // Extract and store start/goal configurations if present
+        if (path.eval("count((/rl/plan|/rlplan)//start/q) > 0").getValue<bool>())
+        {
+            rl::xml::NodeSet start = path.eval("(/rl/plan|/rlplan)//start/q").getValue<rl::xml::NodeSet>();
+            state->start = std::make_shared<rl::math::Vector>(start.size());
+            for (int i = 0; i < start.size(); ++i)
+            {
+                (*state->start)(i) = std::atof(start[i].getContent().c_str());
+                if ("deg" == start[i].getProperty("unit"))
+                {
+                    (*state->start)(i) *= rl::math::constants::deg2rad;
+                }
+            }
+        }
+        
+        if (path.eval("count((/rl/plan|/rlplan)//goal/q) > 0").getValue<bool>())
+        {
+            rl::xml::NodeSet goal = path.eval("(/rl/plan|/rlplan)//goal/q").getValue<rl::xml::NodeSet>();
+            state->goal = std::make_shared<rl::math::Vector>(goal.size());
+            for (int i = 0; i < goal.size(); ++i)
+            {
+                (*state->goal)(i) = std::atof(goal[i].getContent().c_str());
+                if ("deg" == goal[i].getProperty("unit"))
+                {
+                    (*state->goal)(i) *= rl::math::constants::deg2rad;
+                }
+            }
+        }
+        
+        // Create persistent planner components
+        state->sampler = std::make_shared<ConstrainedSampler>();
+        state->sampler->model = state->model.get();
+        
+        state->verifier = std::make_shared<rl::plan::RecursiveVerifier>();
+        state->verifier->delta = delta;
+        state->verifier->model = state->model.get();
+        
+        state->nearestNeighbors = std::make_shared<CountingNearestNeighbors>(
+            std::make_shared<rl::plan::LinearNearestNeighbors>(state->model.get()));
+        
+        state->optimizer = std::make_shared<rl::plan::SimpleOptimizer>();
+        state->optimizer->model = state->model.get();
+        state->optimizer->verifier = state->verifier.get();
+        
+        // Create planner
+        state->planner = createPlanner(plannerTypeStr, state->sampler, state->verifier, state->nearestNeighbors, delta, epsilon, state->localPlanner, state->jacobianDamping);
+        if (!state->planner)
+        {
+            RL_LOG_ERROR("LoadPlanXml: Failed to create planner of type: " << plannerTypeStr);
+            return RL_ERROR_LOAD_FAILED;
+        }
+        
+        state->planner->model = state->model.get();
+        state->planner->duration = std::chrono::milliseconds(timeoutMs);
+        
+        if (state->start)
+        {
+            state->planner->start = state->start.get();
+        }
+        if (state->goal)
+        {
+            state->planner->goal = state->goal.get();
+        }
+        
+        RL_LOG_INFO("LoadPlanXml: Successfully loaded plan XML with planner type: " << plannerTypeStr);
+        
+        return RL_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        RL_LOG_ERROR("LoadPlanXml exception: " << e.what() << " for file: " << xmlPath);
+        return RL_ERROR_LOAD_FAILED;
+    }
+    catch (...)
+    {
+        RL_LOG_ERROR("LoadPlanXml unknown exception for file: " << xmlPath);
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int LoadPlanXml(void* planner, const char* xmlPath)
+{
+    TraceScope trace("LoadPlanXml");
+    std::chrono::steady_clock::time_point callStart = std::chrono::steady_clock::now();
+    int result = loadPlanXml(planner, xmlPath);
+    MetricsRegistry::instance().record(METRIC_LOAD + 20 + metricResultIndex(result), std::chrono::steady_clock::now() - callStart);
+    return result;
+}
+
+RL_PLANNER_API int SetCollisionEngine(void* planner, const char* engine)
+{
+    if (!planner || !engine)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    PlannerState* state = static_cast<PlannerState*>(planner);
+    
+    // Robot contexts share the scene of their planner instance
+    if (state->parent)
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    std::string engineStr = engine;
+    bool available = engineStr.empty();
+    for (int i = 0; collisionEngines[i]; ++i)
+    {
+        available = available || engineStr == collisionEngines[i];
+    }
+    if (!available)
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    state->collisionEngine = engineStr;
+    
+    return RL_SUCCESS;
+}
+
+RL_PLANNER_API int GetCollisionEngines(char* buffer, int bufferSize, int* length)
+{
+    if (!length || (!buffer && bufferSize > 0))
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    std::string text;
+    for (int i = 0; collisionEngines[i]; ++i)
+    {
+        text += (i > 0 ? "," : "") + std::string(collisionEngines[i]);
+    }
+    
+    *length = static_cast<int>(text.size());
+    if (static_cast<int>(text.size()) >= bufferSize)
+    {
+        return RL_ERROR_BUFFER_TOO_SMALL;
+    }
+    
+    std::memcpy(buffer, text.c_str(), text.size() + 1);
+    return RL_SUCCESS;
+}
+
+RL_PLANNER_API int SetStartConfiguration(void* planner, const double* config, int configSize)
+{
+    if (!planner || !config)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    if (configSize <= 0)
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        if (!state->initialized || !state->model)
+        {
+            return RL_ERROR_NOT_INITIALIZED;
+        }
+        
+        int dof = static_cast<int>(state->model->getDofPosition());
+        if (configSize != dof)
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        // Create or update start vector
+        if (!state->start || state->start->size() != dof)
+        {
+            state->start = std::make_shared<rl::math::Vector>(dof);
+        }
+        
+        for (int i = 0; i < dof; ++i)
+        {
+            (*state->start)(i) = config[i];
+        }
+        
+        // Validate configuration
+        if (!state->model->isValid(*state->start))
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        // Update planner's start pointer if planner exists
+        if (state->planner)
+        {
+            state->planner->start = state->start.get();
+        }
+        
+        return RL_SUCCESS;
+    }
+    catch (const std::exception&)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int SetGoalConfiguration(void* planner, const double* config, int configSize)
+{
+    if (!planner || !config)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    if (configSize <= 0)
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        if (!state->initialized || !state->model)
+        {
+            return RL_ERROR_NOT_INITIALIZED;
+        }
+        
+        int dof = static_cast<int>(state->model->getDofPosition());
+        if (configSize != dof)
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        // Create or update goal vector
+        if (!state->goal || state->goal->size() != dof)
+        {
+            state->goal = std::make_shared<rl::math::Vector>(dof);
+        }
+        
+        for (int i = 0; i < dof; ++i)
+        {
+            (*state->goal)(i) = config[i];
+        }
+        
+        // Validate configuration
+        if (!state->model->isValid(*state->goal))
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        // Update planner's goal pointer if planner exists
+        if (state->planner)
+        {
+            state->planner->goal = state->goal.get();
+        }
+        
+        return RL_SUCCESS;
+    }
+    catch (const std::exception&)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+// Helper function to run a one-off planner between two configurations
+static bool solveSegment(PlannerState* state, std::shared_ptr<rl::plan::Verifier> verifier, double delta,
+    rl::math::Vector& start, rl::math::Vector& goal, std::chrono::steady_clock::duration duration, rl::plan::VectorList& path)
+{
+    std::shared_ptr<rl::plan::NearestNeighbors> nearestNeighbors = std::make_shared<rl::plan::LinearNearestNeighbors>(state->model.get());
+    std::shared_ptr<rl::plan::Planner> planner = createPlanner(state->plannerType, state->sampler, verifier, nearestNeighbors,
+        delta, state->epsilon, state->localPlanner, state->jacobianDamping);
+    if (!planner)
+    {
+        return false;
+    }
+    
+    planner->model = state->model.get();
+    planner->start = &start;
+    planner->goal = &goal;
+    planner->duration = duration;
+    
+    if (!planner->verify() || !planner->solve())
+    {
+        return false;
+    }
+    
+    path = planner->getPath();
+    return true;
+}
+
+// Helper function for hierarchical planning: plan with coarse resolution and inflated
+// obstacles, then re-verify each coarse segment at full resolution and replan only
+// the segments that fail
+static bool solveHierarchical(PlannerState* state, const rl::math::Vector& start, const rl::math::Vector& goal,
+    std::chrono::steady_clock::duration duration, rl::plan::VectorList& path)
+{
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + duration;
+    double coarseDelta = state->delta * state->coarseFactor;
+    
+    std::shared_ptr<rl::plan::Verifier> coarseVerifier = std::make_shared<rl::plan::RecursiveVerifier>();
+    coarseVerifier->delta = coarseDelta;
+    coarseVerifier->model = state->model.get();
+    
+    rl::math::Vector coarseStart = start;
+    rl::math::Vector coarseGoal = goal;
+    rl::plan::VectorList coarsePath;
+    
+    state->model->clearanceMargin = state->inflationMargin;
+    bool solved = false;
+    try
+    {
+        // Spend at most half of the budget on the coarse plan
+        solved = solveSegment(state, coarseVerifier, coarseDelta, coarseStart, coarseGoal, duration / 2, coarsePath);
+    }
+    catch (...)
+    {
+        state->model->clearanceMargin = 0;
+        throw;
+    }
+    state->model->clearanceMargin = 0;
+    
+    if (!solved || coarsePath.empty())
+    {
+        return false;
+    }
+    
+    path.clear();
+    path.push_back(coarsePath.front());
+    
+    for (rl::plan::VectorList::iterator i = coarsePath.begin(), j = ++coarsePath.begin(); j != coarsePath.end(); ++i, ++j)
+    {
+        if (!state->verifier->isColliding(*i, *j, state->model->distance(*i, *j)))
+        {
+            path.push_back(*j);
+            continue;
+        }
+        
+        // Local repair of the failing segment at full resolution
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+        {
+            return false;
+        }
+        
+        rl::plan::VectorList repaired;
+        if (!solveSegment(state, state->verifier, state->delta, *i, *j, deadline - now, repaired))
+        {
+            return false;
+        }
+        
+        path.insert(path.end(), ++repaired.begin(), repaired.end());
+    }
+    
+    return true;
+}
+
+// Helper function to map planner type aliases to the names used by LoadPlanXml
+static std::string canonicalPlannerType(const std::string& plannerType)
+{
+    if ("RRT" == plannerType)
+    {
+        return "rrt";
+    }
+    if ("RRTConCon" == plannerType || "rrtConnect" == plannerType || "RRTConnect" == plannerType)
+    {
+        return "rrtConCon";
+    }
+    if ("RRTGoalBias" == plannerType)
+    {
+        return "rrtGoalBias";
+    }
+    if ("PRM" == plannerType)
+    {
+        return "prm";
+    }
+    return plannerType;
+}
+
+// Helper function to apply a pending seed to the sampler and planner; the shortcut optimizer takes it when it runs
+static void seedRandomSources(PlannerState* state, rl::plan::Planner* planner)
+{
+    if (rl::plan::UniformSampler* sampler = dynamic_cast<rl::plan::UniformSampler*>(state->sampler.get()))
+    {
+        sampler->seed(state->seed);
+    }
+    
+    if (rl::plan::RrtGoalBias* goalBias = dynamic_cast<rl::plan::RrtGoalBias*>(planner))
+    {
+        goalBias->seed(state->seed + 1);
+    }
+    
+    state->seedPending = false;
+    state->shortcutSeedPending = true;
+}
+
+// Helper function to return milliseconds since start and restart the stage clock
+static double lapMs(std::chrono::steady_clock::time_point& start)
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double, std::milli>(now - start).count();
+    start = now;
+    return elapsed;
+}
+
+// Helper function to reset the counters collected for planning statistics
+static void resetPlanCounters(PlannerState* state)
+{
+    state->model->collisionChecks = 0;
+    
+    if (ConstrainedSampler* sampler = dynamic_cast<ConstrainedSampler*>(state->sampler.get()))
+    {
+        sampler->samples = 0;
+    }
+    
+    if (CountingNearestNeighbors* nearestNeighbors = dynamic_cast<CountingNearestNeighbors*>(state->nearestNeighbors.get()))
+    {
+        nearestNeighbors->queries = 0;
+    }
+    
+    if (state->roadmap)
+    {
+        state->roadmap->resetQueries();
+    }
+    
+    for (std::size_t i = 0; i < state->verificationContexts.size(); ++i)
+    {
+        state->verificationContexts[i]->model.collisionChecks = 0;
+    }
+}
+
+// Helper function to copy the counters of a planning call to its statistics
+static void collectPlanCounters(PlannerState* state, rl::plan::Planner* planner)
+{
+    std::size_t collisionChecks = state->model->collisionChecks;
+    for (std::size_t i = 0; i < state->verificationContexts.size(); ++i)
+    {
+        collisionChecks += state->verificationContexts[i]->model.collisionChecks;
+    }
+    state->stats.collisionChecks = static_cast<long long>(collisionChecks);
+    
+    if (ConstrainedSampler* sampler = dynamic_cast<ConstrainedSampler*>(state->sampler.get()))
+    {
+        state->stats.samples = static_cast<long long>(sampler->samples);
+    }
+    
+    if (CountingNearestNeighbors* nearestNeighbors = dynamic_cast<CountingNearestNeighbors*>(state->nearestNeighbors.get()))
+    {
+        state->stats.nearestNeighborQueries = static_cast<long long>(nearestNeighbors->queries);
+    }
+    
+    if (state->roadmap && !state->model->constraints.isActive())
+    {
+        state->stats.treeSize = static_cast<long long>(state->roadmap->size());
+        state->stats.nearestNeighborQueries += static_cast<long long>(state->roadmap->getQueries());
+    }
+    else if (rl::plan::Rrt* rrt = dynamic_cast<rl::plan::Rrt*>(planner))
+    {
+        state->stats.treeSize = static_cast<long long>(rrt->getNumVertices());
+    }
+    else if (rl::plan::Prm* prm = dynamic_cast<rl::plan::Prm*>(planner))
+    {
+        state->stats.treeSize = static_cast<long long>(prm->getNumVertices());
+    }
+}
+
+// Helper function to plan and optimize a path on a planner instance
+// Start/goal fall back to the stored configurations, parameters to the stored defaults
+static int solvePath(
+    PlannerState* state,
+    const double* start, int startSize,
+    const double* goal, int goalSize,
+    int useZAxis, const char* plannerType,
+    double delta, double epsilon, int timeoutMs,
+    rl::plan::VectorList& path)
+{
+    if (!state->initialized || !state->model)
+    {
+        return RL_ERROR_NOT_INITIALIZED;
+    }
+    
+    std::chrono::steady_clock::time_point stageStart = std::chrono::steady_clock::now();
+    resetPlanCounters(state);
+    
+    int dof = static_cast<int>(state->model->getDofPosition());
+    
+    // Determine start/goal vectors - use parameters if provided, otherwise use stored
+    rl::math::Vector* startVec = nullptr;
+    rl::math::Vector* goalVec = nullptr;
+    std::shared_ptr<rl::math::Vector> tempStart;
+    std::shared_ptr<rl::math::Vector> tempGoal;
+    
+    if (start && startSize > 0)
+    {
+        if (startSize != dof)
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        tempStart = std::make_shared<rl::math::Vector>(dof);
+        for (int i = 0; i < dof; ++i)
+        {
+            (*tempStart)(i) = start[i];
+        }
+        startVec = tempStart.get();
+    }
+    else if (state->start)
+    {
+        startVec = state->start.get();
+    }
+    else
+    {
+        return RL_ERROR_INVALID_PARAMETER; // No start configuration
+    }
+    
+    if (goal && goalSize > 0)
+    {
+        if (goalSize != dof)
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        tempGoal = std::make_shared<rl::math::Vector>(dof);
+        for (int i = 0; i < dof; ++i)
+        {
+            (*tempGoal)(i) = goal[i];
+        }
+        goalVec = tempGoal.get();
+    }
+    else if (state->goal)
+    {
+        goalVec = state->goal.get();
+    }
+    else
+    {
+        return RL_ERROR_INVALID_PARAMETER; // No goal configuration
+    }
+    
+    // Resolve constraints for this call; without Z-axis the last joint stays at its start value
+    int lockedZAxisIndex = (!useZAxis && dof >= 3 && goal && goalSize > 0) ? dof - 1 : -1;
+    ConstraintScope constraintScope(*state->model, state->constraints, *startVec, lockedZAxisIndex);
+    
+    // Goal must lie on the constraint manifold
+    if (state->model->constraints.isActive())
+    {
+        if (!tempGoal)
+        {
+            tempGoal = std::make_shared<rl::math::Vector>(*goalVec);
+            goalVec = tempGoal.get();
+        }
+        if (!state->model->project(*goalVec))
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+    }
+    
+    // An explicitly requested planner type replaces a persistent planner of another type
+    if (state->planner && plannerType && strlen(plannerType) > 0 &&
+        canonicalPlannerType(plannerType) != canonicalPlannerType(state->plannerType))
+    {
+        state->planner.reset();
+    }
+    
+    // Use persistent planner if available, otherwise create new one
+    std::shared_ptr<rl::plan::Planner> rlPlanner = state->planner;
+    
+    if (!rlPlanner)
+    {
+        // Create planner components if not already created
+        if (!state->sampler)
+        {
+            state->sampler = std::make_shared<ConstrainedSampler>();
+            state->sampler->model = state->model.get();
+        }
+        
+        if (!state->verifier)
+        {
+            state->verifier = std::make_shared<rl::plan::RecursiveVerifier>();
+            state->verifier->delta = delta > 0 ? delta : state->delta;
+            state->verifier->model = state->model.get();
+        }
+        
+        if (!state->nearestNeighbors)
+        {
+            state->nearestNeighbors = std::make_shared<CountingNearestNeighbors>(
+                std::make_shared<rl::plan::LinearNearestNeighbors>(state->model.get()));
+        }
+        
+        // Determine planner type
+        std::string plannerTypeStr;
+        if (plannerType && strlen(plannerType) > 0)
+        {
+            plannerTypeStr = plannerType;
+        }
+        else if (!state->plannerType.empty())
+        {
+            plannerTypeStr = state->plannerType;
+        }
+        else
+        {
+            plannerTypeStr = "rrtConCon"; // Default
+        }
+        
+        // Use provided parameters or stored defaults
+        double useDelta = delta > 0 ? delta : state->delta;
+        double useEpsilon = epsilon > 0 ? epsilon : state->epsilon;
+        int useTimeout = timeoutMs > 0 ? timeoutMs : state->timeoutMs;
+        
+        // Create planner
+        rlPlanner = createPlanner(plannerTypeStr, state->sampler, state->verifier, state->nearestNeighbors, useDelta, useEpsilon, state->localPlanner, state->jacobianDamping);
+        if (!rlPlanner)
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        rlPlanner->model = state->model.get();
+        rlPlanner->duration = std::chrono::milliseconds(useTimeout);
+        
+        // Store planner for reuse
+        state->planner = rlPlanner;
+        state->plannerType = plannerTypeStr;
+        state->delta = useDelta;
+        state->epsilon = useEpsilon;
+        state->timeoutMs = useTimeout;
+    }
+    
+    // Update planner with current start/goal
+    rlPlanner->start = startVec;
+    rlPlanner->goal = goalVec;
+    
+    if (state->seedPending)
+    {
+        seedRandomSources(state, rlPlanner.get());
+    }
+    
+    // Update timeout if provided
+    if (timeoutMs > 0)
+    {
+        rlPlanner->duration = std::chrono::milliseconds(timeoutMs);
+    }
+    
+    state->stats.argumentTimeMs = lapMs(stageStart);
+    
+    // Verify start and goal configurations
+    TraceScope verifyTrace("verify");
+    bool verified = rlPlanner->verify();
+    verifyTrace.end();
+    state->stats.verifyTimeMs = lapMs(stageStart);
+    if (!verified)
+    {
+        collectPlanCounters(state, rlPlanner.get());
+        return RL_ERROR_PLANNING_FAILED;
+    }
+    
+    // Plan trajectory, reusing the persistent roadmap in replanning mode
+    path.clear();
+    bool solved = false;
+    TraceScope solveTrace("solve");
+    
+    try
+    {
+        if (state->roadmap && !state->model->constraints.isActive())
+        {
+            solved = state->roadmap->solve(state->model.get(), state->sampler.get(), state->verifier.get(),
+                createDynamicCost(state, state->model.get()), *startVec, *goalVec, rlPlanner->duration, path);
+        }
+        else
+        {
+            // Hierarchical mode falls back to the full resolution planner if coarse planning or repair fails
+            if (state->hierarchical)
+            {
+                std::chrono::steady_clock::duration duration = rlPlanner->duration;
+                std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + duration;
+                solved = solveHierarchical(state, *startVec, *goalVec, duration, path);
+                
+                // Fallback gets only the time the hierarchical attempt left over
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                if (!solved && now < deadline)
+                {
+                    rlPlanner->duration = deadline - now;
+                    try
+                    {
+                        solved = rlPlanner->solve();
+                    }
+                    catch (...)
+                    {
+                        rlPlanner->duration = duration;
+                        throw;
+                    }
+                    rlPlanner->duration = duration;
+                    if (solved)
+                    {
+                        path = rlPlanner->getPath();
+                    }
+                }
+            }
+            else
+            {
+                solved = rlPlanner->solve();
+                if (solved)
+                {
+                    path = rlPlanner->getPath();
+                }
+            }
+        }
+    }
+    catch (const ConstraintProjectionError& e)
+    {
+        RL_LOG_WARNING("PlanTrajectory: " << e.what());
+        path.clear();
+        solved = false;
+    }
+    
+    solveTrace.end();
+    state->stats.solveTimeMs = lapMs(stageStart);
+    
+    if (!solved)
+    {
+        collectPlanCounters(state, rlPlanner.get());
+        return RL_ERROR_PLANNING_FAILED;
+    }
+    
+    std::size_t waypointsBefore = path.size();
+    TraceScope optimizeTrace("optimize");
+    
+    // Optimize path if optimizer is available
+    if ("advanced" == state->optimizerType)
+    {
+        state->stats.shortcuts = static_cast<long long>(optimizeParallel(state, path));
+    }
+    else if (state->optimizer)
+    {
+        state->optimizer->process(path);
+    }
+    else
+    {
+        // Create temporary optimizer if not available
+        std::shared_ptr<rl::plan::SimpleOptimizer> optimizer = std::make_shared<rl::plan::SimpleOptimizer>();
+        optimizer->model = state->model.get();
+        optimizer->verifier = state->verifier.get();
+        optimizer->process(path);
+    }
+    
+    // Vertices removed by the simple optimizer are its shortcuts
+    if ("advanced" != state->optimizerType && path.size() < waypointsBefore)
+    {
+        state->stats.shortcuts = static_cast<long long>(waypointsBefore - path.size());
+    }
+    
+    // Blend corners of optimized path
+    if (state->blendRadius > 0)
+    {
+        PathSmoother smoother;
+        smoother.model = state->model.get();
+        smoother.verifier = state->verifier.get();
+        smoother.radius = state->blendRadius;
+        smoother.samples = state->blendSamples;
+        smoother.process(path);
+    }
+    
+    optimizeTrace.end();
+    state->stats.optimizeTimeMs = lapMs(stageStart);
+    collectPlanCounters(state, rlPlanner.get());
+    
+    return RL_SUCCESS;
+}
+
+// Helper function to add the time spent copying waypoints to the caller to the statistics
+static void recordCopyTime(PlannerState* state, std::chrono::steady_clock::time_point copyStart)
+{
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - copyStart).count();
+    state->stats.copyTimeMs = elapsed;
+    state->stats.totalTimeMs += elapsed;
+}
+
+// Helper function to record the latency and work counters of a planning call in the process-wide metrics
+static void recordPlanMetrics(PlannerState* state, int series, std::chrono::steady_clock::time_point callStart)
+{
+    MetricsRegistry& metrics = MetricsRegistry::instance();
+    metrics.record(series, std::chrono::steady_clock::now() - callStart);
+    metrics.add(METRIC_COLLISION_CHECKS, static_cast<std::uint64_t>(state->stats.collisionChecks));
+    metrics.add(METRIC_SAMPLES, static_cast<std::uint64_t>(state->stats.samples));
+    metrics.add(METRIC_NEAREST_NEIGHBOR_QUERIES, static_cast<std::uint64_t>(state->stats.nearestNeighborQueries));
+    metrics.add(METRIC_SHORTCUTS, static_cast<std::uint64_t>(state->stats.shortcuts));
+}
+
+// Plan a path for a planner instance or robot context
+static int planPath(
+    PlannerState* state,
+    const double* start, int startSize,
+    const double* goal, int goalSize,
+    int useZAxis, const char* plannerType,
+    double delta, double epsilon, int timeoutMs,
+    rl::plan::VectorList& path)
+{
+    TraceScope trace("plan");
+    std::chrono::steady_clock::time_point callStart = std::chrono::steady_clock::now();
+    state->stats = RL_PlanStats();
+    
+    // Other robots of a shared scene are obstacles at their start configurations
+    if (state->parent || !state->robots.empty())
+    {
+        parkOtherRobots(state);
+    }
+    
+    std::string plannerTypeStr = (plannerType && strlen(plannerType) > 0) ? plannerType : (state->plannerType.empty() ? "rrtConCon" : state->plannerType);
+    int series = METRIC_PLAN + metricPlannerIndex(plannerTypeStr) * 10;
+    
+    int result;
+    try
+    {
+        result = solvePath(state, start, startSize, goal, goalSize, useZAxis, plannerType, delta, epsilon, timeoutMs, path);
+    }
+    catch (...)
+    {
+        MetricsRegistry::instance().record(series + metricResultIndex(RL_ERROR_EXCEPTION), std::chrono::steady_clock::now() - callStart);
+        throw;
+    }
+    
+    if (result != RL_SUCCESS)
+    {
+        state->stats.totalTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - callStart).count();
+        recordPlanMetrics(state, series + metricResultIndex(result), callStart);
+        return result;
+    }
+    
+    // Resample or compress path for output
+    TraceScope outputTrace("output");
+    std::chrono::steady_clock::time_point outputStart = std::chrono::steady_clock::now();
+    if ("joint" == state->outputMode || "cartesian" == state->outputMode)
+    {
+        std::vector<rl::math::Vector> samples;
+        if ("joint" == state->outputMode)
+        {
+            densifyPath(state->model.get(), path, state->outputResolution, samples);
+        }
+        else
+        {
+            densifyPathCartesian(state->model.get(), path, state->outputResolution, samples);
+        }
+        path.assign(samples.begin(), samples.end());
+    }
+    else if ("compress" == state->outputMode)
+    {
+        compressPath(state->model.get(), state->verifier.get(), state->outputResolution, path);
+    }
+    
+    std::chrono::steady_clock::time_point outputEnd = std::chrono::steady_clock::now();
+    state->stats.optimizeTimeMs += std::chrono::duration<double, std::milli>(outputEnd - outputStart).count();
+    state->stats.totalTimeMs = std::chrono::duration<double, std::milli>(outputEnd - callStart).count();
+    recordPlanMetrics(state, series + metricResultIndex(RL_SUCCESS), callStart);
+    
+    return RL_SUCCESS;
+}
+
+RL_PLANNER_API int PlanTrajectory(
+    void* planner,
+    const double* start, int startSize,
+    const double* goal, int goalSize,
+    int useZAxis, const char* plannerType,
+    double delta, double epsilon, int timeoutMs,
+    double* waypoints, int maxWaypoints, int* waypointCount)
+{
+    if (!planner || !waypoints || !waypointCount)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        rl::plan::VectorList path;
+        int result = planPath(state, start, startSize, goal, goalSize, useZAxis, plannerType, delta, epsilon, timeoutMs, path);
+        if (result != RL_SUCCESS)
+        {
+            *waypointCount = 0;
+            return result;
+        }
+        
+        std::chrono::steady_clock::time_point copyStart = std::chrono::steady_clock::now();
+        int dof = static_cast<int>(state->model->getDofPosition());
+        
+        // Copy waypoints to output buffer, reporting the required count if they do not fit
+        int count = static_cast<int>(path.size());
+        *waypointCount = count;
+        if (count > maxWaypoints)
+        {
+            count = maxWaypoints;
+        }
+        
+        int idx = 0;
+        for (auto it = path.begin(); it != path.end() && idx < count; ++it, ++idx)
+        {
+            const rl::math::Vector& waypoint = *it;
+            for (int j = 0; j < dof; ++j)
+            {
+                waypoints[idx * dof + j] = waypoint(j);
+            }
+        }
+        
+        recordCopyTime(state, copyStart);
+        
+        return *waypointCount > maxWaypoints ? RL_ERROR_BUFFER_TOO_SMALL : RL_SUCCESS;
+    }
+    catch (const std::exception&)
+    {
+        return RL_ERROR_PLANNING_FAILED;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int PlanTrajectoryStreaming(
+    void* planner,
+    const double* start, int startSize,
+    const double* goal, int goalSize,
+    int useZAxis, const char* plannerType,
+    double delta, double epsilon, int timeoutMs,
+    int chunkSize, RL_WaypointCallback callback, void* userData, int* waypointCount)
+{
+    if (!planner || !callback || !waypointCount)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    if (chunkSize <= 0)
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        *waypointCount = 0;
+        
+        rl::plan::VectorList path;
+        int result = planPath(state, start, startSize, goal, goalSize, useZAxis, plannerType, delta, epsilon, timeoutMs, path);
+        if (result != RL_SUCCESS)
+        {
+            return result;
+        }
+        
+        std::chrono::steady_clock::time_point copyStart = std::chrono::steady_clock::now();
+        int dof = static_cast<int>(state->model->getDofPosition());
+        
+        // Hand out waypoints in chunks of one reused buffer
+        std::vector<double> chunk(static_cast<std::size_t>(std::min(chunkSize, static_cast<int>(path.size()))) * dof);
+        int count = 0;
+        
+        for (auto it = path.begin(); it != path.end(); )
+        {
+            for (count = 0; it != path.end() && count < chunkSize; ++it, ++count)
+            {
+                for (int j = 0; j < dof; ++j)
+                {
+                    chunk[count * dof + j] = (*it)(j);
+                }
+            }
+            
+            if (callback(chunk.data(), count, dof, userData) != 0)
+            {
+                recordCopyTime(state, copyStart);
+                return RL_ERROR_ABORTED;
+            }
+            
+            *waypointCount += count;
+        }
+        
+        recordCopyTime(state, copyStart);
+        
+        return RL_SUCCESS;
+    }
+    catch (const std::exception&)
+    {
+        return RL_ERROR_PLANNING_FAILED;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int PlanTrajectoryResult(
+    void* planner,
+    const double* start, int startSize,
+    const double* goal, int goalSize,
+    int useZAxis, const char* plannerType,
+    double delta, double epsilon, int timeoutMs,
+    void** result)
+{
+    if (!planner || !result)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    *result = nullptr;
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        rl::plan::VectorList path;
+        int status = planPath(state, start, startSize, goal, goalSize, useZAxis, plannerType, delta, epsilon, timeoutMs, path);
+        if (status != RL_SUCCESS)
+        {
+            return status;
+        }
+        
+        std::chrono::steady_clock::time_point copyStart = std::chrono::steady_clock::now();
+        int dof = static_cast<int>(state->model->getDofPosition());
+        
+        std::unique_ptr<PathResult> pathResult(new PathResult());
+        pathResult->dof = dof;
+        pathResult->count = static_cast<int>(path.size());
+        pathResult->waypoints.resize(path.size() * dof);
+        
+        double* waypoint = pathResult->waypoints.data();
+        for (auto it = path.begin(); it != path.end(); ++it, waypoint += dof)
+        {
+            Eigen::Map<rl::math::Vector>(waypoint, dof) = *it;
+        }
+        
+        *result = pathResult.release();
+        
+        recordCopyTime(state, copyStart);
+        
+        return RL_SUCCESS;
+    }
+    catch (const std::exception&)
+    {
+        return RL_ERROR_PLANNING_FAILED;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int GetPathResult(void* result, const double** waypoints, int* stride, int* count)
+{
+    if (!result || !waypoints || !stride || !count)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    PathResult* pathResult = static_cast<PathResult*>(result);
+    
+    *waypoints = pathResult->waypoints.data();
+    *stride = pathResult->dof;
+    *count = pathResult->count;
+    
+    return RL_SUCCESS;
+}
+
+RL_PLANNER_API void ReleasePathResult(void* result)
+{
+    delete static_cast<PathResult*>(result);
+}
+
+RL_PLANNER_API int SetRandomSeed(void* planner, unsigned int seed)
+{
+    if (!planner)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    PlannerState* state = static_cast<PlannerState*>(planner);
+    
+    state->seed = static_cast<std::uint32_t>(seed);
+    state->seedPending = true;
+    
+    return RL_SUCCESS;
+}
+
+RL_PLANNER_API int GetLastPlanStats(void* planner, RL_PlanStats* stats)
+{
+    if (!planner || !stats)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    PlannerState* state = static_cast<PlannerState*>(planner);
+    
+    *stats = state->stats;
+    
+    return RL_SUCCESS;
+}
+
+RL_PLANNER_API int DumpMetrics(const char* filePath)
+{
+    if (!filePath)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        std::string text = MetricsRegistry::instance().dump();
+        
+        std::ofstream file(filePath, std::ios::out | std::ios::trunc);
+        if (!file)
+        {
+            RL_LOG_ERROR("DumpMetrics: Cannot open file: " << filePath);
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        file << text;
+        return file ? RL_SUCCESS : RL_ERROR_EXCEPTION;
+    }
+    catch (const std::exception& e)
+    {
+        RL_LOG_ERROR("DumpMetrics exception: " << e.what());
+        return RL_ERROR_EXCEPTION;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int DumpMetricsToBuffer(char* buffer, int bufferSize, int* length)
+{
+    if (!length || (!buffer && bufferSize > 0))
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        std::string text = MetricsRegistry::instance().dump();
+        
+        *length = static_cast<int>(text.size());
+        if (static_cast<int>(text.size()) >= bufferSize)
+        {
+            return RL_ERROR_BUFFER_TOO_SMALL;
+        }
+        
+        std::memcpy(buffer, text.c_str(), text.size() + 1);
+        return RL_SUCCESS;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API void EnableTracing(int enabled)
+{
+    TraceBuffer::instance().setEnabled(0 != enabled);
+}
+
+RL_PLANNER_API int ExportTrace(const char* filePath)
+{
+    if (!filePath)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        std::string text = TraceBuffer::instance().dump();
+        
+        std::ofstream file(filePath, std::ios::out | std::ios::trunc);
+        if (!file)
+        {
+            RL_LOG_ERROR("ExportTrace: Cannot open file: " << filePath);
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        file << text;
+        return file ? RL_SUCCESS : RL_ERROR_EXCEPTION;
+    }
+    catch (const std::exception& e)
+    {
+        RL_LOG_ERROR("ExportTrace exception: " << e.what());
+        return RL_ERROR_EXCEPTION;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int SetLogLevel(int level)
+{
+    if (level < RL_LOG_LEVEL_DEBUG || level > RL_LOG_LEVEL_OFF)
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    Logger::instance().setLevel(level);
+    
+    return RL_SUCCESS;
+}
+
+RL_PLANNER_API int SetLogSink(RL_LogCallback callback, void* userData)
+{
+    Logger::instance().flush();
+    Logger::instance().setCallback(callback, userData);
+    
+    return RL_SUCCESS;
+}
+
+RL_PLANNER_API int SetLogFile(const char* filePath)
+{
+    if (!filePath)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    Logger::instance().flush();
+    
+    return Logger::instance().setFile(filePath) ? RL_SUCCESS : RL_ERROR_INVALID_PARAMETER;
+}
+
+RL_PLANNER_API void FlushLog()
+{
+    Logger::instance().flush();
+}
+
+RL_PLANNER_API int SetLocalPlanner(void* planner, const char* localPlannerType, double jacobianDamping)
+{
+    if (!planner || !localPlannerType)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    std::string localPlannerStr = localPlannerType;
+    if (localPlannerStr != "linear" && localPlannerStr != "Linear" &&
+        localPlannerStr != "jacobian" && localPlannerStr != "Jacobian")
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        state->localPlanner = localPlannerStr;
+        state->jacobianDamping = jacobianDamping > 0 ? jacobianDamping : 0.01;
+        
+        // Drop persistent planner so the next PlanTrajectory call recreates it
+        state->planner.reset();
+        
+        return RL_SUCCESS;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int SetHierarchicalPlanning(void* planner, int enable, double coarseFactor, double inflationMargin)
+{
+    if (!planner)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    if (enable && (coarseFactor < 1.0 || inflationMargin < 0.0))
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    PlannerState* state = static_cast<PlannerState*>(planner);
+    
+    state->hierarchical = enable != 0;
+    if (state->hierarchical)
+    {
+        state->coarseFactor = coarseFactor;
+        state->inflationMargin = inflationMargin;
+    }
+    
+    return RL_SUCCESS;
+}
+
+RL_PLANNER_API int SetPathOptimizer(void* planner, const char* optimizerType, int optimizationTimeMs, int threadCount)
+{
+    if (!planner || !optimizerType)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    std::string optimizerTypeStr = optimizerType;
+    if (optimizerTypeStr != "simple" && optimizerTypeStr != "advanced")
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    if (optimizationTimeMs < 0 || threadCount < 0)
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    PlannerState* state = static_cast<PlannerState*>(planner);
+    
+    state->optimizerType = optimizerTypeStr;
+    if (optimizationTimeMs > 0)
+    {
+        state->optimizationTimeMs = optimizationTimeMs;
+    }
+    state->optimizerThreads = threadCount;
+    
+    return RL_SUCCESS;
+}
+
+RL_PLANNER_API int SetPathCost(void* planner, const char* costType, const double* maxTorque, int dof)
+{
+    if (!planner || !costType)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        if (!state->initialized || !state->model)
+        {
+            return RL_ERROR_NOT_INITIALIZED;
+        }
+        
+        std::string costTypeStr = costType;
+        DynamicCost::Type type;
+        if ("length" == costTypeStr)
+        {
+            type = DynamicCost::TYPE_LENGTH;
+        }
+        else if ("time" == costTypeStr)
+        {
+            type = DynamicCost::TYPE_TIME;
+        }
+        else if ("energy" == costTypeStr)
+        {
+            type = DynamicCost::TYPE_ENERGY;
+        }
+        else
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        // Time and energy need inertia and gravity from a dynamic model
+        if (type != DynamicCost::TYPE_LENGTH && !dynamic_cast<rl::mdl::Dynamic*>(state->model->mdl))
+        {
+            RL_LOG_ERROR("SetPathCost: Cost type " << costTypeStr << " requires a dynamic model (rlmdl) in LoadKinematics");
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        if (maxTorque)
+        {
+            if (dof != static_cast<int>(state->model->getDofPosition()))
+            {
+                return RL_ERROR_INVALID_PARAMETER;
+            }
+            state->jointLimits.torque = Eigen::Map<const rl::math::Vector>(maxTorque, dof);
+        }
+        
+        state->costType = type;
+        
+        // Roadmap edge costs refer to the previous cost
+        if (state->roadmap)
+        {
+            state->roadmap->clear();
+        }
+        
+        return RL_SUCCESS;
+    }
+    catch (const std::exception&)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int SetPathSmoothing(void* planner, double blendRadius, int samplesPerBlend)
+{
+    if (!planner)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    if (blendRadius < 0.0 || (blendRadius > 0.0 && samplesPerBlend < 2))
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    PlannerState* state = static_cast<PlannerState*>(planner);
+    
+    state->blendRadius = blendRadius;
+    if (blendRadius > 0.0)
+    {
+        state->blendSamples = samplesPerBlend;
+    }
+    
+    return RL_SUCCESS;
+}
+
+RL_PLANNER_API int SetPathOutput(void* planner, const char* outputMode, double resolution)
+{
+    if (!planner || !outputMode)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    std::string outputModeStr = outputMode;
+    if (outputModeStr != "none" && outputModeStr != "joint" && outputModeStr != "cartesian" && outputModeStr != "compress")
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    if (outputModeStr != "none" && resolution <= 0.0)
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    PlannerState* state = static_cast<PlannerState*>(planner);
+    
+    state->outputMode = outputModeStr;
+    state->outputResolution = resolution;
+    
+    return RL_SUCCESS;
+}
+
+RL_PLANNER_API int AddLockedJointConstraint(void* planner, int jointIndex, double value, int useStartValue)
+{
+    if (!planner)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        if (jointIndex < 0 || (state->model && jointIndex >= static_cast<int>(state->model->getDofPosition())))
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        JointLock lock = { jointIndex, value, useStartValue != 0 };
+        state->constraints.locks.push_back(lock);
+        
+        return RL_SUCCESS;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int AddJointCouplingConstraint(void* planner, int jointIndex, int referenceJointIndex, double ratio, double offset)
+{
+    if (!planner)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        int dof = state->model ? static_cast<int>(state->model->getDofPosition()) : INT_MAX;
+        if (jointIndex < 0 || jointIndex >= dof || referenceJointIndex < 0 || referenceJointIndex >= dof ||
+            jointIndex == referenceJointIndex)
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        JointCoupling coupling = { jointIndex, referenceJointIndex, ratio, offset };
+        state->constraints.couplings.push_back(coupling);
+        
+        return RL_SUCCESS;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int SetToolOrientationConstraint(void* planner, const double* orientation, int axisOnly, double tolerance)
+{
+    if (!planner)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        OrientationConstraint constraint;
+        constraint.enabled = true;
+        constraint.axisOnly = axisOnly != 0;
+        constraint.tolerance = tolerance > 0 ? tolerance : constraint.tolerance;
+        constraint.useStartOrientation = (orientation == nullptr);
+        
+        if (orientation)
+        {
+            rl::math::Quaternion quaternion(orientation[0], orientation[1], orientation[2], orientation[3]);
+            if (quaternion.norm() <= std::numeric_limits<rl::math::Real>::epsilon())
+            {
+                return RL_ERROR_INVALID_PARAMETER;
+            }
+            constraint.target = quaternion.normalized().toRotationMatrix();
+        }
+        
+        state->constraints.orientation = constraint;
+        
+        return RL_SUCCESS;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int ClearConstraints(void* planner)
+{
+    if (!planner)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    PlannerState* state = static_cast<PlannerState*>(planner);
+    state->constraints = PlanningConstraints();
+    
+    return RL_SUCCESS;
+}
+
+RL_PLANNER_API int BuildReachabilityMap(void* planner, const char* outputPath, double voxelSize, int samples)
+{
+    if (!planner || !outputPath)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    if (voxelSize <= 0 || samples <= 0)
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        if (!state->initialized || !state->model)
+        {
+            return RL_ERROR_NOT_INITIALIZED;
+        }
+        
+        // Seeded with the seed of SetRandomSeed (0 by default), so maps are reproducible
+        rl::plan::UniformSampler sampler;
+        sampler.model = state->model.get();
+        sampler.seed(state->seed);
+        
+        // Sample collision-free configurations and record the tool positions reached
+        std::vector<rl::math::Vector3> positions;
+        std::vector<int> bins;
+        positions.reserve(samples);
+        bins.reserve(samples);
+        
+        for (int i = 0; i < samples; ++i)
+        {
+            rl::math::Vector q = sampler.generate();
+            state->model->setPosition(q);
+            state->model->updateFrames();
+            
+            if (state->model->isColliding())
+            {
+                continue;
+            }
+            
+            const rl::math::Transform& tool = state->model->forwardPosition();
+            positions.push_back(tool.translation());
+            bins.push_back(ReachabilityMap::orientationBin(tool.linear().col(2)));
+        }
+        
+        if (positions.empty())
+        {
+            RL_LOG_ERROR("BuildReachabilityMap: No collision-free samples found");
+            return RL_ERROR_PLANNING_FAILED;
+        }
+        
+        rl::math::Vector3 minimum = positions[0];
+        rl::math::Vector3 maximum = positions[0];
+        for (std::size_t i = 1; i < positions.size(); ++i)
+        {
+            minimum = minimum.cwiseMin(positions[i]);
+            maximum = maximum.cwiseMax(positions[i]);
+        }
+        
+        std::shared_ptr<ReachabilityMap> map = std::make_shared<ReachabilityMap>();
+        map->dof = static_cast<int>(state->model->getDofPosition());
+        map->voxelSize = voxelSize;
+        map->origin = minimum;
+        for (int i = 0; i < 3; ++i)
+        {
+            map->dims[i] = static_cast<int>(std::floor((maximum(i) - minimum(i)) / voxelSize)) + 1;
+        }
+        map->counts.assign(static_cast<std::size_t>(map->dims[0]) * map->dims[1] * map->dims[2] * ReachabilityMap::ORIENTATION_BINS, 0);
+        
+        for (std::size_t i = 0; i < positions.size(); ++i)
+        {
+            long index = map->voxelIndex(positions[i]);
+            if (index >= 0)
+            {
+                map->add(index, bins[i]);
+            }
+        }
+        
+        RL_LOG_INFO("BuildReachabilityMap: " << positions.size() << " of " << samples << " samples collision-free, grid "
+            << map->dims[0] << "x" << map->dims[1] << "x" << map->dims[2]);
+        
+        if (!saveReachabilityMap(*map, outputPath))
+        {
+            RL_LOG_ERROR("BuildReachabilityMap: Failed to write file: " << outputPath);
+            return RL_ERROR_LOAD_FAILED;
+        }
+        
+        state->reachabilityMap = map;
+        
+        return RL_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        RL_LOG_ERROR("BuildReachabilityMap exception: " << e.what());
+        return RL_ERROR_EXCEPTION;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int LoadReachabilityMap(void* planner, const char* mapPath)
+{
+    if (!planner || !mapPath)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        std::shared_ptr<ReachabilityMap> map = loadReachabilityMap(mapPath);
+        if (!map)
+        {
+            RL_LOG_ERROR("LoadReachabilityMap: Failed to read file: " << mapPath);
+            return RL_ERROR_LOAD_FAILED;
+        }
+        
+        if (state->model && map->dof != static_cast<int>(state->model->getDofPosition()))
+        {
+            RL_LOG_ERROR("LoadReachabilityMap: Map DOF " << map->dof << " does not match model DOF");
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        state->reachabilityMap = map;
+        
+        return RL_SUCCESS;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int IsPoseReachable(void* planner, const double* pose, int poseSize)
+{
+    if (!planner || !pose)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        if (!state->reachabilityMap)
+        {
+            return RL_ERROR_NOT_INITIALIZED;
+        }
+        
+        rl::math::Transform transform;
+        bool hasOrientation = false;
+        if (!readPose(pose, poseSize, transform, hasOrientation))
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        int samples = 0;
+        int orientations = 0;
+        state->reachabilityMap->lookup(transform, hasOrientation, samples, orientations);
+        
+        return samples > 0 ? 1 : 0;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int GetPoseReachability(void* planner, const double* pose, int poseSize, int* samples, int* orientations)
+{
+    if (!planner || !pose || !samples || !orientations)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        if (!state->reachabilityMap)
+        {
+            return RL_ERROR_NOT_INITIALIZED;
+        }
+        
+        rl::math::Transform transform;
+        bool hasOrientation = false;
+        if (!readPose(pose, poseSize, transform, hasOrientation))
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        state->reachabilityMap->lookup(transform, hasOrientation, *samples, *orientations);
+        
+        return RL_SUCCESS;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int PlanTrajectoryToPose(
+    void* planner,
+    const double* start, int startSize,
+    const double* goalPose, int goalPoseSize,
+    const char* plannerType,
+    double delta, double epsilon, int timeoutMs,
+    double* waypoints, int maxWaypoints, int* waypointCount)
+{
+    if (!planner || !goalPose || !waypoints || !waypointCount)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        if (!state->initialized || !state->model)
+        {
+            return RL_ERROR_NOT_INITIALIZED;
+        }
+        
+        *waypointCount = 0;
+        int dof = static_cast<int>(state->model->getDofPosition());
+        
+        rl::math::Transform target;
+        bool hasOrientation = false;
+        if (!readPose(goalPose, goalPoseSize, target, hasOrientation))
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        rl::math::Vector startVec(dof);
+        if (start && startSize > 0)
+        {
+            if (startSize != dof)
+            {
+                return RL_ERROR_INVALID_PARAMETER;
+            }
+            for (int i = 0; i < dof; ++i)
+            {
+                startVec(i) = start[i];
+            }
+        }
+        else if (state->start)
+        {
+            startVec = *state->start;
+        }
+        else
+        {
+            return RL_ERROR_INVALID_PARAMETER; // No start configuration
+        }
+        
+        // Solve IK seeded from start, then from random samples; the reachability map is sampled and can miss
+        // reachable poses, so it never rejects a goal but grants more seeds to goals it has seen reached
+        rl::plan::UniformSampler sampler;
+        sampler.model = state->model.get();
+        sampler.seed(state->seed);
+        
+        int maxSeeds = 20;
+        if (state->reachabilityMap)
+        {
+            int samples = 0;
+            int orientations = 0;
+            state->reachabilityMap->lookup(target, hasOrientation, samples, orientations);
+            maxSeeds = samples > 0 ? 100 : maxSeeds;
+        }
+        
+        rl::math::Vector goalVec(dof);
+        bool found = false;
+        
+        for (int i = 0; i < maxSeeds && !found; ++i)
+        {
+            rl::math::Vector seed = (i == 0) ? startVec : sampler.generate();
+            if (solveInverseKinematics(state->model.get(), target, hasOrientation, seed, goalVec))
+            {
+                state->model->setPosition(goalVec);
+                state->model->updateFrames();
+                found = !state->model->isColliding();
+            }
+        }
+        
+        if (!found)
+        {
+            return RL_ERROR_GOAL_UNREACHABLE;
+        }
+        
+        return PlanTrajectory(planner, startVec.data(), dof, goalVec.data(), dof, 1, plannerType,
+            delta, epsilon, timeoutMs, waypoints, maxWaypoints, waypointCount);
+    }
+    catch (const std::exception&)
+    {
+        return RL_ERROR_PLANNING_FAILED;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int SetReplanningMode(void* planner, int enable)
+{
+    if (!planner)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        if (!enable)
+        {
+            state->roadmap.reset();
+        }
+        else if (!state->roadmap)
+        {
+            state->roadmap = std::make_shared<IncrementalRoadmap>();
+            state->roadmap->margin = state->replanningMargin;
+        }
+        
+        return RL_SUCCESS;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int SetReplanningMargin(void* planner, double margin)
+{
+    if (!planner)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    if (!(margin >= 0))
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    PlannerState* state = static_cast<PlannerState*>(planner);
+    state->replanningMargin = margin;
+    if (state->roadmap)
+    {
+        state->roadmap->margin = margin;
+    }
+    
+    return RL_SUCCESS;
+}
+
+RL_PLANNER_API int MoveSceneBody(void* planner, int modelIndex, int bodyIndex, const double* pose, int poseSize)
+{
+    if (!planner || !pose)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        if (!state->initialized || !state->scene)
+        {
+            return RL_ERROR_NOT_INITIALIZED;
+        }
+        
+        if (modelIndex < 0 || modelIndex >= static_cast<int>(state->scene->getNumModels()))
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        rl::sg::Model* model = state->scene->getModel(modelIndex);
+        if (model == state->robotModel || bodyIndex < 0 || bodyIndex >= static_cast<int>(model->getNumBodies()))
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        rl::math::Transform frame;
+        bool hasOrientation = false;
+        if (!readPose(pose, poseSize, frame, hasOrientation))
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        rl::sg::Body* body = model->getBody(bodyIndex);
+        rl::math::Transform current;
+        body->getFrame(current);
+        if (!hasOrientation)
+        {
+            frame.linear() = current.linear();
+        }
+        body->setFrame(frame);
+        
+        // Cached collision results of the roadmap near the old and new position no longer hold
+        if (state->roadmap)
+        {
+            state->roadmap->invalidate(current.translation(), frame.translation());
+        }
+        
+        return RL_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        RL_LOG_ERROR("MoveSceneBody exception: " << e.what());
+        return RL_ERROR_EXCEPTION;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int AddRobotModel(void* planner, const char* kinematicsXmlPath, int robotModelIndex)
+{
+    if (!planner || !kinematicsXmlPath)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        if (state->parent)
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        if (!state->initialized || !state->scene)
+        {
+            return RL_ERROR_NOT_INITIALIZED;
+        }
+        
+        if (robotModelIndex < 0 || robotModelIndex >= static_cast<int>(state->scene->getNumModels()))
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        rl::sg::Model* robotModel = state->scene->getModel(robotModelIndex);
+        if (robotModel == state->robotModel)
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        for (std::size_t i = 0; i < state->robots.size(); ++i)
+        {
+            if (robotModel == state->robots[i]->robotModel)
+            {
+                return RL_ERROR_INVALID_PARAMETER;
+            }
+        }
+        
+        std::shared_ptr<PlannerState> robot = std::make_shared<PlannerState>();
+        robot->plannerType = state->plannerType;
+        robot->delta = state->delta;
+        robot->epsilon = state->epsilon;
+        robot->timeoutMs = state->timeoutMs;
+        robot->localPlanner = state->localPlanner;
+        robot->jacobianDamping = state->jacobianDamping;
+        robot->optimizerType = state->optimizerType;
+        robot->optimizationTimeMs = state->optimizationTimeMs;
+        robot->optimizerThreads = state->optimizerThreads;
+        robot->costType = state->costType;
+        
+        int result = LoadKinematics(robot.get(), kinematicsXmlPath);
+        if (result != RL_SUCCESS)
+        {
+            return result;
+        }
+        
+        // Share scene with the primary robot
+        robot->scene = state->scene;
+        result = bindRobotModel(robot.get(), robotModelIndex);
+        if (result != RL_SUCCESS)
+        {
+            return result;
+        }
+        
+        robot->parent = state;
+        state->robots.push_back(robot);
+        
+        return static_cast<int>(state->robots.size());
+    }
+    catch (const std::exception& e)
+    {
+        RL_LOG_ERROR("AddRobotModel exception: " << e.what() << " for file: " << kinematicsXmlPath);
+        return RL_ERROR_LOAD_FAILED;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int GetRobotCount(void* planner)
+{
+    if (!planner)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    PlannerState* state = static_cast<PlannerState*>(planner);
+    
+    if (state->parent)
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    return 1 + static_cast<int>(state->robots.size());
+}
+
+RL_PLANNER_API void* GetRobotPlanner(void* planner, int robotIndex)
+{
+    if (!planner)
+    {
+        return nullptr;
+    }
+    
+    PlannerState* state = static_cast<PlannerState*>(planner);
+    
+    if (state->parent || robotIndex < 0 || robotIndex > static_cast<int>(state->robots.size()))
+    {
+        return nullptr;
+    }
+    
+    if (robotIndex == 0)
+    {
+        return planner;
+    }
+    
+    return static_cast<void*>(state->robots[robotIndex - 1].get());
+}
+
+RL_PLANNER_API int PlanCoordinatedTrajectory(
+    void* planner,
+    const double* starts, int startsSize,
+    const double* goals, int goalsSize,
+    const char* plannerType,
+    double delta, double epsilon, int timeoutMs,
+    double* waypoints, int maxWaypoints, int* waypointCount)
+{
+    if (!planner || !starts || !goals || !waypoints || !waypointCount)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        if (!state->initialized || !state->model)
+        {
+            return RL_ERROR_NOT_INITIALIZED;
+        }
+        
+        *waypointCount = 0;
+        
+        // Robots in priority order, primary robot first
+        std::vector<PlannerState*> robots(1, state);
+        for (std::size_t i = 0; i < state->robots.size(); ++i)
+        {
+            robots.push_back(state->robots[i].get());
+        }
+        
+        int totalDof = 0;
+        std::vector<rl::math::Vector> startVecs;
+        std::vector<rl::math::Vector> goalVecs;
+        for (std::size_t r = 0; r < robots.size(); ++r)
+        {
+            int dof = static_cast<int>(robots[r]->model->getDofPosition());
+            if (totalDof + dof > startsSize || totalDof + dof > goalsSize)
+            {
+                return RL_ERROR_INVALID_PARAMETER;
+            }
+            startVecs.push_back(Eigen::Map<const rl::math::Vector>(starts + totalDof, dof));
+            goalVecs.push_back(Eigen::Map<const rl::math::Vector>(goals + totalDof, dof));
+            totalDof += dof;
+        }
+        if (startsSize != totalDof || goalsSize != totalDof)
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        int useTimeout = timeoutMs > 0 ? timeoutMs : state->timeoutMs;
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(useTimeout);
+        rl::math::Real resolution = delta > 0 ? delta : state->delta;
+        
+        std::vector<PlannerState*> reserved;
+        std::vector<std::vector<rl::math::Vector>> reservations;
+        
+        for (std::size_t r = 0; r < robots.size(); ++r)
+        {
+            // Plan path with higher-priority robots parked at their goals, lower-priority at their starts
+            for (std::size_t s = 0; s < robots.size(); ++s)
+            {
+                if (s != r)
+                {
+                    robots[s]->model->setPosition(s < r ? goalVecs[s] : startVecs[s]);
+                    robots[s]->model->updateFrames();
+                }
+            }
+            
+            int remainingMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count());
+            if (remainingMs <= 0)
+            {
+                return RL_ERROR_PLANNING_FAILED;
+            }
+            
+            rl::plan::VectorList path;
+            int dof = static_cast<int>(startVecs[r].size());
+            int result = solvePath(robots[r], startVecs[r].data(), dof, goalVecs[r].data(), dof, 1, plannerType,
+                delta, epsilon, remainingMs, path);
+            if (result != RL_SUCCESS)
+            {
+                return result;
+            }
+            
+            std::vector<rl::math::Vector> samples;
+            densifyPath(robots[r]->model.get(), path, resolution, samples);
+            
+            // Lower-priority robots wait at their starts while being scheduled around
+            for (std::size_t s = r + 1; s < robots.size(); ++s)
+            {
+                robots[s]->model->setPosition(startVecs[s]);
+                robots[s]->model->updateFrames();
+            }
+            
+            std::vector<std::size_t> schedule;
+            if (!scheduleRobot(robots[r], samples, reserved, reservations, deadline, schedule))
+            {
+                return RL_ERROR_PLANNING_FAILED;
+            }
+            
+            std::vector<rl::math::Vector> timed;
+            timed.reserve(schedule.size());
+            for (std::size_t t = 0; t < schedule.size(); ++t)
+            {
+                timed.push_back(samples[schedule[t]]);
+            }
+            
+            reserved.push_back(robots[r]);
+            reservations.push_back(timed);
+        }
+        
+        // Copy composite configurations per time step to output buffer
+        std::size_t steps = 0;
+        for (std::size_t r = 0; r < reservations.size(); ++r)
+        {
+            steps = std::max(steps, reservations[r].size());
+        }
+        
+        int count = std::min(static_cast<int>(steps), maxWaypoints);
+        *waypointCount = static_cast<int>(steps);
+        
+        for (int t = 0; t < count; ++t)
+        {
+            int offset = 0;
+            for (std::size_t r = 0; r < reservations.size(); ++r)
+            {
+                const rl::math::Vector& q = reservations[r][std::min(static_cast<std::size_t>(t), reservations[r].size() - 1)];
+                for (int j = 0; j < q.size(); ++j)
+                {
+                    waypoints[t * totalDof + offset + j] = q(j);
+                }
+                offset += static_cast<int>(q.size());
+            }
+        }
+        
+        return *waypointCount > maxWaypoints ? RL_ERROR_BUFFER_TOO_SMALL : RL_SUCCESS;
+    }
+    catch (const std::exception&)
+    {
+        return RL_ERROR_PLANNING_FAILED;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int SetJointLimits(void* planner, const double* maxVelocity, const double* maxAcceleration, const double* maxJerk, int dof)
+{
+    if (!planner || !maxVelocity || !maxAcceleration)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    if (dof <= 0)
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    PlannerState* state = static_cast<PlannerState*>(planner);
+    
+    if (state->model && dof != static_cast<int>(state->model->getDofPosition()))
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
+    for (int i = 0; i < dof; ++i)
     {
-        std::cerr << "LoadPlanXml unknown exception for file: " << xmlPath << std::endl;
-        return RL_ERROR_EXCEPTION;
+        if (maxVelocity[i] <= 0 || maxAcceleration[i] <= 0)
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
     }
+    
+    state->jointLimits.velocity = Eigen::Map<const rl::math::Vector>(maxVelocity, dof);
+    state->jointLimits.acceleration = Eigen::Map<const rl::math::Vector>(maxAcceleration, dof);
+    state->jointLimits.jerk = maxJerk ? rl::math::Vector(Eigen::Map<const rl::math::Vector>(maxJerk, dof)) : rl::math::Vector::Zero(dof);
+    
+    return RL_SUCCESS;
 }
 
-RL_PLANNER_API int SetStartConfiguration(void* planner, const double* config, int configSize)
+RL_PLANNER_API int TimeParameterizePath(void* planner, const double* waypoints, int waypointCount, double* timestamps)
 {
-    if (!planner || !config)
+    if (!planner || !waypoints || !timestamps)
     {
         return RL_ERROR_INVALID_POINTER;
     }
     
-    if (configSize <= 0)
+    if (waypointCount <= 0)
     {
         return RL_ERROR_INVALID_PARAMETER;
     }
@@ -561,33 +6352,20 @@ RL_PLANNER_API int SetStartConfiguration(void* planner, const double* config, in
             return RL_ERROR_NOT_INITIALIZED;
         }
         
-        int dof = static_cast<int>(state->model->getDofPosition());
-        if (configSize != dof)
-        {
-            return RL_ERROR_INVALID_PARAMETER;
-        }
-        
-        // Create or update start vector
-        if (!state->start || state->start->size() != dof)
-        {
-            state->start = std::make_shared<rl::math::Vector>(dof);
-        }
-        
-        for (int i = 0; i < dof; ++i)
-        {
-            (*state->start)(i) = config[i];
-        }
+        std::vector<rl::math::Vector> path;
+        readWaypoints(waypoints, waypointCount, static_cast<int>(state->model->getDofPosition()), path);
         
-        // Validate configuration
-        if (!state->model->isValid(*state->start))
+        TimeOptimalParameterization parameterization;
+        if (!parameterization.process(path, state->jointLimits))
         {
-            return RL_ERROR_INVALID_PARAMETER;
+            return RL_ERROR_PLANNING_FAILED;
         }
         
-        // Update planner's start pointer if planner exists
-        if (state->planner)
+        const std::vector<rl::math::Real>& times = parameterization.getTimes();
+        const std::vector<std::size_t>& indices = parameterization.getWaypointIndices();
+        for (int i = 0; i < waypointCount; ++i)
         {
-            state->planner->start = state->start.get();
+            timestamps[i] = times[indices[i]];
         }
         
         return RL_SUCCESS;
@@ -602,14 +6380,18 @@ RL_PLANNER_API int SetStartConfiguration(void* planner, const double* config, in
     }
 }
 
-RL_PLANNER_API int SetGoalConfiguration(void* planner, const double* config, int configSize)
+RL_PLANNER_API int SampleTrajectory(
+    void* planner,
+    const double* waypoints, int waypointCount,
+    double sampleTime,
+    double* positions, double* velocities, int maxSamples, int* sampleCount)
 {
-    if (!planner || !config)
+    if (!planner || !waypoints || !positions || !sampleCount)
     {
         return RL_ERROR_INVALID_POINTER;
     }
     
-    if (configSize <= 0)
+    if (waypointCount <= 0 || sampleTime <= 0)
     {
         return RL_ERROR_INVALID_PARAMETER;
     }
@@ -624,35 +6406,38 @@ RL_PLANNER_API int SetGoalConfiguration(void* planner, const double* config, int
         }
         
         int dof = static_cast<int>(state->model->getDofPosition());
-        if (configSize != dof)
-        {
-            return RL_ERROR_INVALID_PARAMETER;
-        }
+        std::vector<rl::math::Vector> path;
+        readWaypoints(waypoints, waypointCount, dof, path);
         
-        // Create or update goal vector
-        if (!state->goal || state->goal->size() != dof)
-        {
-            state->goal = std::make_shared<rl::math::Vector>(dof);
-        }
-        
-        for (int i = 0; i < dof; ++i)
+        TimeOptimalParameterization parameterization;
+        if (!parameterization.process(path, state->jointLimits))
         {
-            (*state->goal)(i) = config[i];
+            *sampleCount = 0;
+            return RL_ERROR_PLANNING_FAILED;
         }
         
-        // Validate configuration
-        if (!state->model->isValid(*state->goal))
-        {
-            return RL_ERROR_INVALID_PARAMETER;
-        }
+        // Samples at multiples of sampleTime, last sample at the end of the trajectory
+        double duration = parameterization.getDuration();
+        int required = static_cast<int>(std::ceil(duration / sampleTime)) + 1;
+        int count = std::min(required, maxSamples);
+        *sampleCount = required;
         
-        // Update planner's goal pointer if planner exists
-        if (state->planner)
+        rl::math::Vector position(dof);
+        rl::math::Vector velocity(dof);
+        for (int i = 0; i < count; ++i)
         {
-            state->planner->goal = state->goal.get();
+            parameterization.sample(std::min(i * sampleTime, duration), position, velocity);
+            for (int j = 0; j < dof; ++j)
+            {
+                positions[i * dof + j] = position(j);
+                if (velocities)
+                {
+                    velocities[i * dof + j] = velocity(j);
+                }
+            }
         }
         
-        return RL_SUCCESS;
+        return required > maxSamples ? RL_ERROR_BUFFER_TOO_SMALL : RL_SUCCESS;
     }
     catch (const std::exception&)
     {
@@ -664,19 +6449,21 @@ RL_PLANNER_API int SetGoalConfiguration(void* planner, const double* config, int
     }
 }
 
-RL_PLANNER_API int PlanTrajectory(
+RL_PLANNER_API int EvaluatePathMetrics(
     void* planner,
-    const double* start, int startSize,
-    const double* goal, int goalSize,
-    int useZAxis, const char* plannerType,
-    double delta, double epsilon, int timeoutMs,
-    double* waypoints, int maxWaypoints, int* waypointCount)
+    const double* waypoints, const int* waypointCounts, int pathCount,
+    int threadCount, double* metrics)
 {
-    if (!planner || !waypoints || !waypointCount)
+    if (!planner || !waypoints || !waypointCounts || !metrics)
     {
         return RL_ERROR_INVALID_POINTER;
     }
     
+    if (pathCount <= 0 || threadCount < 0)
+    {
+        return RL_ERROR_INVALID_PARAMETER;
+    }
+    
     try
     {
         PlannerState* state = static_cast<PlannerState*>(planner);
@@ -688,191 +6475,61 @@ RL_PLANNER_API int PlanTrajectory(
         
         int dof = static_cast<int>(state->model->getDofPosition());
         
-        // Determine start/goal vectors - use parameters if provided, otherwise use stored
-        rl::math::Vector* startVec = nullptr;
-        rl::math::Vector* goalVec = nullptr;
-        std::shared_ptr<rl::math::Vector> tempStart;
-        std::shared_ptr<rl::math::Vector> tempGoal;
-        
-        if (start && startSize > 0)
+        // Offsets of the paths in the concatenated waypoint buffer
+        std::vector<std::size_t> offsets(pathCount + 1, 0);
+        for (int i = 0; i < pathCount; ++i)
         {
-            if (startSize != dof)
+            if (waypointCounts[i] < 0)
             {
                 return RL_ERROR_INVALID_PARAMETER;
             }
-            tempStart = std::make_shared<rl::math::Vector>(dof);
-            for (int i = 0; i < dof; ++i)
-            {
-                (*tempStart)(i) = start[i];
-            }
-            startVec = tempStart.get();
+            offsets[i + 1] = offsets[i] + static_cast<std::size_t>(waypointCounts[i]) * dof;
         }
-        else if (state->start)
-        {
-            startVec = state->start.get();
-        }
-        else
+        
+        // Planning model on this thread, verification contexts on the others
+        if (0 == threadCount)
         {
-            return RL_ERROR_INVALID_PARAMETER; // No start configuration
+            threadCount = static_cast<int>(std::thread::hardware_concurrency());
         }
+        threadCount = std::max(1, std::min(threadCount, pathCount));
         
-        if (goal && goalSize > 0)
+        std::vector<PlanningModel*> models(1, state->model.get());
+        if (threadCount > 1)
         {
-            if (goalSize != dof)
-            {
-                return RL_ERROR_INVALID_PARAMETER;
-            }
-            tempGoal = std::make_shared<rl::math::Vector>(dof);
-            for (int i = 0; i < dof; ++i)
-            {
-                (*tempGoal)(i) = goal[i];
-            }
-            
-            // Handle Z-axis constraint
-            if (!useZAxis && dof >= 3 && startVec)
+            std::vector<VerificationContext*> contexts = acquireVerificationContexts(state, threadCount - 1);
+            for (std::size_t i = 0; i < contexts.size(); ++i)
             {
-                int zAxisIndex = dof - 1;
-                constrainZAxis(*tempGoal, *startVec, zAxisIndex);
+                models.push_back(&contexts[i]->model);
             }
-            goalVec = tempGoal.get();
-        }
-        else if (state->goal)
-        {
-            goalVec = state->goal.get();
-        }
-        else
-        {
-            return RL_ERROR_INVALID_PARAMETER; // No goal configuration
         }
         
-        // Use persistent planner if available, otherwise create new one
-        std::shared_ptr<rl::plan::Planner> rlPlanner = state->planner;
+        rl::math::Real resolution = state->verifier ? state->verifier->delta : state->delta;
         
-        if (!rlPlanner)
+        std::function<void(std::size_t)> evaluate = [&](std::size_t worker)
         {
-            // Create planner components if not already created
-            if (!state->sampler)
-            {
-                state->sampler = std::make_shared<rl::plan::UniformSampler>();
-                state->sampler->model = state->model.get();
-            }
-            
-            if (!state->verifier)
-            {
-                state->verifier = std::make_shared<rl::plan::RecursiveVerifier>();
-                state->verifier->delta = delta > 0 ? delta : state->delta;
-                state->verifier->model = state->model.get();
-            }
-            
-            if (!state->nearestNeighbors)
-            {
-                state->nearestNeighbors = std::make_shared<rl::plan::LinearNearestNeighbors>(state->model.get());
-            }
-            
-            // Determine planner type
-            std::string plannerTypeStr;
-            if (plannerType && strlen(plannerType) > 0)
-            {
-                plannerTypeStr = plannerType;
-            }
-            else if (!state->plannerType.empty())
-            {
-                plannerTypeStr = state->plannerType;
-            }
-            else
-            {
-                plannerTypeStr = "rrtConCon"; // Default
-            }
-            
-            // Use provided parameters or stored defaults
-            double useDelta = delta > 0 ? delta : state->delta;
-            double useEpsilon = epsilon > 0 ? epsilon : state->epsilon;
-            int useTimeout = timeoutMs > 0 ? timeoutMs : state->timeoutMs;
-            
-            // Create planner
-            rlPlanner = createPlanner(plannerTypeStr, state->sampler, state->verifier, state->nearestNeighbors, useDelta, useEpsilon);
-            if (!rlPlanner)
+            for (std::size_t i = worker; i < static_cast<std::size_t>(pathCount); i += models.size())
             {
-                return RL_ERROR_INVALID_PARAMETER;
+                evaluatePathMetrics(models[worker], state->jointLimits, resolution,
+                    waypoints + offsets[i], waypointCounts[i], dof, metrics + i * RL_PATH_METRIC_COUNT);
             }
-            
-            rlPlanner->model = state->model.get();
-            rlPlanner->duration = std::chrono::milliseconds(useTimeout);
-            
-            // Store planner for reuse
-            state->planner = rlPlanner;
-            state->plannerType = plannerTypeStr;
-            state->delta = useDelta;
-            state->epsilon = useEpsilon;
-            state->timeoutMs = useTimeout;
-        }
-        
-        // Update planner with current start/goal
-        rlPlanner->start = startVec;
-        rlPlanner->goal = goalVec;
-        
-        // Update timeout if provided
-        if (timeoutMs > 0)
-        {
-            rlPlanner->duration = std::chrono::milliseconds(timeoutMs);
-        }
-        
-        // Verify start and goal configurations
-        if (!rlPlanner->verify())
-        {
-            return RL_ERROR_PLANNING_FAILED;
-        }
-        
-        // Plan trajectory
-        bool solved = rlPlanner->solve();
-        
-        if (!solved)
-        {
-            *waypointCount = 0;
-            return RL_ERROR_PLANNING_FAILED;
-        }
-        
-        // Get path
-        rl::plan::VectorList path = rlPlanner->getPath();
-        
-        // Optimize path if optimizer is available
-        if (state->optimizer)
-        {
-            state->optimizer->process(path);
-        }
-        else
-        {
-            // Create temporary optimizer if not available
-            std::shared_ptr<rl::plan::SimpleOptimizer> optimizer = std::make_shared<rl::plan::SimpleOptimizer>();
-            optimizer->model = state->model.get();
-            optimizer->verifier = state->verifier.get();
-            optimizer->process(path);
-        }
+        };
         
-        // Copy waypoints to output buffer
-        int count = static_cast<int>(path.size());
-        if (count > maxWaypoints)
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < models.size(); ++i)
         {
-            count = maxWaypoints;
+            threads.emplace_back(evaluate, i);
         }
-        
-        *waypointCount = count;
-        
-        int idx = 0;
-        for (auto it = path.begin(); it != path.end() && idx < count; ++it, ++idx)
+        evaluate(0);
+        for (std::size_t i = 0; i < threads.size(); ++i)
         {
-            const rl::math::Vector& waypoint = *it;
-            for (int j = 0; j < dof; ++j)
-            {
-                waypoints[idx * dof + j] = waypoint(j);
-            }
+            threads[i].join();
         }
         
         return RL_SUCCESS;
     }
     catch (const std::exception&)
     {
-        return RL_ERROR_PLANNING_FAILED;
+        return RL_ERROR_EXCEPTION;
     }
     catch (...)
     {
@@ -880,12 +6537,11 @@ RL_PLANNER_API int PlanTrajectory(
     }
 }
 
-RL_PLANNER_API int IsValidConfiguration(void* planner, const double* config, int configSize)
+static int isValidConfiguration(void* planner, const double* config, int configSize)
 {
     if (!planner || !config)
     {
-        std::cerr << "IsValidConfiguration: Null planner or config pointer" << std::endl;
-        std::cerr.flush();
+        RL_LOG_ERROR("IsValidConfiguration: Null planner or config pointer");
         return 0;
     }
     
@@ -899,7 +6555,7 @@ RL_PLANNER_API int IsValidConfiguration(void* planner, const double* config, int
         }
         
         // Check if kinematics is properly set
-        if (!state->kinematics)
+        if (!state->kinematics && !state->mdl)
         {
             return 0;
         }
@@ -1013,18 +6669,147 @@ RL_PLANNER_API int IsValidConfiguration(void* planner, const double* config, int
     }
     catch (const std::exception& e)
     {
-        std::cerr << "IsValidConfiguration: Exception: " << e.what() << std::endl;
-        std::cerr.flush();
+        RL_LOG_ERROR("IsValidConfiguration: Exception: " << e.what());
         return 0;
     }
     catch (...)
     {
-        std::cerr << "IsValidConfiguration: Unknown exception" << std::endl;
-        std::cerr.flush();
+        RL_LOG_ERROR("IsValidConfiguration: Unknown exception");
         return 0;
     }
 }
 
+RL_PLANNER_API int IsValidConfiguration(void* planner, const double* config, int configSize)
+{
+    std::chrono::steady_clock::time_point callStart = std::chrono::steady_clock::now();
+    int result = isValidConfiguration(planner, config, configSize);
+    MetricsRegistry::instance().record(METRIC_VALIDITY + (result ? 0 : 1), std::chrono::steady_clock::now() - callStart);
+    return result;
+}
+
+RL_PLANNER_API int IsValidSegment(void* planner, const double* from, const double* to, int configSize)
+{
+    if (!planner || !from || !to)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        if (!state->initialized || !state->model)
+        {
+            return RL_ERROR_NOT_INITIALIZED;
+        }
+        
+        int dof = static_cast<int>(state->model->getDofPosition());
+        if (configSize != dof)
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        rl::math::Vector u(dof);
+        rl::math::Vector v(dof);
+        for (int i = 0; i < dof; ++i)
+        {
+            u(i) = from[i];
+            v(i) = to[i];
+        }
+        
+        if (!state->model->isValid(u) || !state->model->isValid(v))
+        {
+            return 0;
+        }
+        
+        if (!state->verifier)
+        {
+            state->verifier = std::make_shared<rl::plan::RecursiveVerifier>();
+            state->verifier->model = state->model.get();
+            state->verifier->delta = state->delta > 0 ? state->delta : 0.1;
+        }
+        
+        // Endpoints are checked explicitly, the verifier only checks interior configurations
+        state->model->setPosition(u);
+        state->model->updateFrames();
+        if (state->model->isColliding())
+        {
+            return 0;
+        }
+        
+        state->model->setPosition(v);
+        state->model->updateFrames();
+        if (state->model->isColliding())
+        {
+            return 0;
+        }
+        
+        return state->verifier->isColliding(u, v, state->model->distance(u, v)) ? 0 : 1;
+    }
+    catch (const std::exception& e)
+    {
+        RL_LOG_ERROR("IsValidSegment: Exception: " << e.what());
+        return RL_ERROR_EXCEPTION;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
+RL_PLANNER_API int ForwardKinematics(void* planner, const double* config, int configSize, double* pose, int poseSize)
+{
+    if (!planner || !config || !pose)
+    {
+        return RL_ERROR_INVALID_POINTER;
+    }
+    
+    try
+    {
+        PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        if (!state->initialized || !state->model)
+        {
+            return RL_ERROR_NOT_INITIALIZED;
+        }
+        
+        int dof = static_cast<int>(state->model->getDofPosition());
+        if (configSize != dof || (poseSize != 3 && poseSize != 7))
+        {
+            return RL_ERROR_INVALID_PARAMETER;
+        }
+        
+        rl::math::Vector q(dof);
+        for (int i = 0; i < dof; ++i)
+        {
+            q(i) = config[i];
+        }
+        
+        state->model->setPosition(q);
+        state->model->updateFrames(false);
+        const rl::math::Transform& tool = state->model->forwardPosition();
+        
+        pose[0] = tool.translation().x();
+        pose[1] = tool.translation().y();
+        pose[2] = tool.translation().z();
+        
+        if (poseSize == 7)
+        {
+            rl::math::Quaternion orientation(tool.linear());
+            pose[3] = orientation.w();
+            pose[4] = orientation.x();
+            pose[5] = orientation.y();
+            pose[6] = orientation.z();
+        }
+        
+        return RL_SUCCESS;
+    }
+    catch (...)
+    {
+        return RL_ERROR_EXCEPTION;
+    }
+}
+
 RL_PLANNER_API int GetDof(void* planner)
 {
     if (!planner)
@@ -1054,6 +6839,13 @@ RL_PLANNER_API void DestroyPlanner(void* planner)
     if (planner)
     {
         PlannerState* state = static_cast<PlannerState*>(planner);
+        
+        // Robot contexts are owned by their planner instance
+        if (state->parent)
+        {
+            return;
+        }
+        
         delete state;
     }
 }
@@ -28,6 +28,47 @@ extern "C" {
 #define RL_ERROR_PLANNING_FAILED -4
 #define RL_ERROR_NOT_INITIALIZED -5
 #define RL_ERROR_EXCEPTION -6
+#define RL_ERROR_BUFFER_TOO_SMALL -7
+#define RL_ERROR_ABORTED -8
+#define RL_ERROR_GOAL_UNREACHABLE -9
+
+// Log levels (see SetLogLevel)
+#define RL_LOG_LEVEL_DEBUG 0
+#define RL_LOG_LEVEL_INFO 1
+#define RL_LOG_LEVEL_WARNING 2
+#define RL_LOG_LEVEL_ERROR 3
+#define RL_LOG_LEVEL_OFF 4
+
+// Values per path returned by EvaluatePathMetrics
+#define RL_PATH_METRIC_LENGTH 0
+#define RL_PATH_METRIC_MIN_CLEARANCE 1
+#define RL_PATH_METRIC_JOINT_REVERSALS 2
+#define RL_PATH_METRIC_DURATION 3
+#define RL_PATH_METRIC_COUNT 4
+
+// Statistics of the last planning call of a planner instance (see GetLastPlanStats)
+// Wall times in milliseconds; counters cover the whole call
+typedef struct RL_PlanStats
+{
+    double argumentTimeMs;          // start/goal conversion, constraints and planner setup
+    double verifyTimeMs;            // start and goal verification
+    double solveTimeMs;             // path search
+    double optimizeTimeMs;          // optimization, smoothing and output resampling
+    double copyTimeMs;              // copying waypoints to the caller
+    double totalTimeMs;             // whole call
+    long long treeSize;             // vertices of the tree or roadmap
+    long long samples;              // configurations drawn by the sampler
+    long long collisionChecks;      // configurations checked for collision
+    long long nearestNeighborQueries;
+    long long shortcuts;            // shortcuts applied or waypoints removed by the optimizer
+} RL_PlanStats;
+
+// Receives log messages on the background log writer thread (see SetLogSink)
+typedef void (*RL_LogCallback)(int level, const char* message, void* userData);
+
+// Receives count waypoints (flattened: count * dof values) during PlanTrajectoryStreaming
+// The buffer is only valid during the call; return 0 to continue, nonzero to stop
+typedef int (*RL_WaypointCallback)(const double* waypoints, int count, int dof, void* userData);
 
 // Create planner instance - maintains scene and kinematics for lifetime
 RL_PLANNER_API void* CreatePlanner();
@@ -47,6 +88,16 @@ RL_PLANNER_API int LoadScene(void* planner, const char* xmlPath, int robotModelI
 // Returns RL_SUCCESS (0) on success, negative error code on failure
 RL_PLANNER_API int LoadPlanXml(void* planner, const char* xmlPath);
 
+// Select the collision engine of scenes loaded by later LoadScene and LoadPlanXml calls
+// engine: "fcl", "ode", "pqp", "bullet" or "solid" if compiled in, "" for the default (first compiled engine)
+// Returns RL_SUCCESS (0) on success, RL_ERROR_INVALID_PARAMETER if the engine is not compiled in
+RL_PLANNER_API int SetCollisionEngine(void* planner, const char* engine);
+
+// Get the compiled-in collision engines as a null-terminated comma-separated list, default engine first
+// length: output - text length without terminator; RL_ERROR_BUFFER_TOO_SMALL if bufferSize <= length
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int GetCollisionEngines(char* buffer, int bufferSize, int* length);
+
 // Set start configuration - stored in planner instance for reuse
 // Returns RL_SUCCESS (0) on success, negative error code on failure
 RL_PLANNER_API int SetStartConfiguration(void* planner, const double* config, int configSize);
@@ -57,10 +108,16 @@ RL_PLANNER_API int SetGoalConfiguration(void* planner, const double* config, int
 
 // Plan trajectory - uses pre-loaded scene and kinematics
 // Automatically checks collisions against scene obstacles
+// Planning constraints (see Add*Constraint) are applied to sampling, extension and the goal
+// useZAxis: if 0 and DOF >= 3, the last joint is locked at its start value (goal is projected)
 // waypoints: output buffer for waypoints (flattened: waypointCount * dof values)
 // maxWaypoints: maximum number of waypoints that can be stored
-// waypointCount: output - actual number of waypoints returned
-// Returns RL_SUCCESS (0) on success, negative error code on failure
+// waypointCount: output - number of waypoints of the path
+// Returns RL_SUCCESS (0) on success, RL_ERROR_BUFFER_TOO_SMALL if the path has more than
+// maxWaypoints waypoints, negative error code on failure
+// On RL_ERROR_BUFFER_TOO_SMALL only the first maxWaypoints waypoints are written and waypointCount
+// is the full count; calling again with that many plans anew and may find a longer path, use
+// PlanTrajectoryResult to get a path of any length at once
 RL_PLANNER_API int PlanTrajectory(
     void* planner,
     const double* start, int startSize,
@@ -69,10 +126,337 @@ RL_PLANNER_API int PlanTrajectory(
     double delta, double epsilon, int timeoutMs,
     double* waypoints, int maxWaypoints, int* waypointCount);
 
+// Plan trajectory like PlanTrajectory, passing waypoints to callback in chunks of at most
+// chunkSize waypoints instead of copying them into a fixed-size buffer
+// waypointCount: output - number of waypoints passed to callback
+// Returns RL_SUCCESS (0) on success, RL_ERROR_ABORTED if callback returned nonzero,
+// negative error code on failure
+RL_PLANNER_API int PlanTrajectoryStreaming(
+    void* planner,
+    const double* start, int startSize,
+    const double* goal, int goalSize,
+    int useZAxis, const char* plannerType,
+    double delta, double epsilon, int timeoutMs,
+    int chunkSize, RL_WaypointCallback callback, void* userData, int* waypointCount);
+
+// Plan trajectory like PlanTrajectory, returning the path in a result handle instead of copying
+// it into a caller buffer; read it in place with GetPathResult and free it with ReleasePathResult
+// result: output - result handle, null on failure
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int PlanTrajectoryResult(
+    void* planner,
+    const double* start, int startSize,
+    const double* goal, int goalSize,
+    int useZAxis, const char* plannerType,
+    double delta, double epsilon, int timeoutMs,
+    void** result);
+
+// Access the waypoints of a result handle without copying
+// waypoints: output - contiguous waypoint storage, valid and fixed in memory until ReleasePathResult
+// stride: output - number of values between consecutive waypoints (dof)
+// count: output - number of waypoints
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int GetPathResult(void* result, const double** waypoints, int* stride, int* count);
+
+// Release a result handle and its waypoint storage
+RL_PLANNER_API void ReleasePathResult(void* result);
+
+// Seed the random sources of the next planning call (sampler, goal bias and shortcut optimizer)
+// Later calls continue the seeded sequences; with the same seed, plan and options a call draws the same
+// samples, results still differ when a timeout or optimization budget cuts the search short
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int SetRandomSeed(void* planner, unsigned int seed);
+
+// Get statistics of the last PlanTrajectory, PlanTrajectoryStreaming or PlanTrajectoryResult call,
+// including failed calls; stats are zero before the first call
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int GetLastPlanStats(void* planner, RL_PlanStats* stats);
+
+// Write process-wide metrics of all planner instances and threads in Prometheus text format:
+// latency histograms (rlwrapper_plan_duration_seconds by planner and result,
+// rlwrapper_validity_check_duration_seconds by result, rlwrapper_load_duration_seconds by file and result)
+// with p50/p90/p99/p999 estimates, and counters of collision checks, samples, nearest neighbor queries and shortcuts
+// Recording is lock-free per thread; dumping may run concurrently with planning
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int DumpMetrics(const char* filePath);
+
+// Same as DumpMetrics, writing the null-terminated text to a caller buffer
+// length: output - text length without terminator; RL_ERROR_BUFFER_TOO_SMALL if bufferSize <= length
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int DumpMetricsToBuffer(char* buffer, int bufferSize, int* length);
+
+// Enable (1) or disable (0, default) recording of trace events for all planner instances:
+// begin/end events of LoadPlanXml, LoadKinematics, LoadScene and of the plan, verify, solve,
+// optimize and output phases of planning calls, with thread IDs
+// Events go to a process-wide lock-free ring buffer keeping the most recent 65536 events
+RL_PLANNER_API void EnableTracing(int enabled);
+
+// Write the recorded trace events as Chrome trace JSON, viewable in Perfetto (ui.perfetto.dev)
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int ExportTrace(const char* filePath);
+
+// Set the minimum level of logged messages (RL_LOG_LEVEL_*, default RL_LOG_LEVEL_INFO)
+// Messages are queued and written by a background thread, which sleeps while the queue is empty and
+// is stopped at process exit or library unload after writing the queued messages; debug messages
+// are only compiled in when building with RLWRAPPER_LOG_MIN_LEVEL=0
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int SetLogLevel(int level);
+
+// Send log messages to a callback instead of stderr; a null callback restores stderr
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int SetLogSink(RL_LogCallback callback, void* userData);
+
+// Append log messages to a file instead of stderr
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int SetLogFile(const char* filePath);
+
+// Wait until all log messages queued so far are written, e.g. before changing or releasing a log callback
+RL_PLANNER_API void FlushLog();
+
+// Select the local planner used by tree planners (rrt, rrtConCon, rrtGoalBias) to extend towards samples
+// localPlannerType: "linear" (straight joint-space step, default) or "jacobian" (extend and connect steps
+// steer the tool frame using the damped Jacobian pseudo-inverse towards the workspace pose of their target;
+// every tenth extend step targets the goal tool pose, e.g. the pose given to PlanTrajectoryToPose)
+// jacobianDamping: damping factor for the pseudo-inverse, <= 0 uses the default (0.01)
+// Takes effect on the next PlanTrajectory call
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int SetLocalPlanner(void* planner, const char* localPlannerType, double jacobianDamping);
+
+// Enable or disable hierarchical planning
+// PlanTrajectory first plans with verifier resolution delta * coarseFactor while treating
+// configurations closer than inflationMargin to obstacles as colliding, then re-verifies the
+// coarse path at full resolution and replans only failing segments; if that fails it plans
+// at full resolution in the time left. inflationMargin requires an engine with distance queries
+// (FCL, Bullet, PQP, SOLID), other engines plan without inflation; it should cover the workspace
+// motion of one coarse step.
+// coarseFactor: >= 1; inflationMargin: >= 0 (0 disables inflation)
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int SetHierarchicalPlanning(void* planner, int enable, double coarseFactor, double inflationMargin);
+
+// Select the path optimizer run after each solve
+// "simple": rl SimpleOptimizer without time limit (default)
+// "advanced": random full and partial (single joint) shortcuts checked in parallel on private
+// copies of the scene, stopping at optimizationTimeMs
+// optimizationTimeMs: > 0, or 0 to keep the current budget (default 1000)
+// threadCount: > 0, or 0 for one thread per hardware thread; each thread loads the scene once
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int SetPathOptimizer(void* planner, const char* optimizerType, int optimizationTimeMs, int threadCount);
+
+// Select the cost minimized by the "advanced" path optimizer and by the replanning roadmap
+// "length": joint space path length (default)
+// "time": execution time of each segment from rest to rest, with cruising speed and acceleration
+// allowed by the joint speed limits and by the torque limits against gravity, centrifugal, Coriolis
+// and inertial forces
+// "energy": absolute mechanical work against gravity, centrifugal and Coriolis forces plus the
+// kinetic energy of accelerating and braking each segment
+// "time" and "energy" require a dynamic model (rlmdl file) loaded by LoadKinematics.
+// maxTorque: per-joint torque limits (dof values), or null to keep the current limits (unlimited
+// after LoadKinematics, rlkin and rlmdl files have no torque limits); limits <= 0 are unlimited
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int SetPathCost(void* planner, const char* costType, const double* maxTorque, int dof);
+
+// Select how PlanTrajectory, PlanTrajectoryStreaming and PlanTrajectoryResult output the path
+// "none": waypoints as planned and optimized (default)
+// "joint": waypoints kept, segments subdivided into samples at most resolution apart in joint space
+// "cartesian": waypoints kept, segments subdivided until the tool frame moves at most resolution
+// (scene units) between samples
+// "compress": fewest waypoints within resolution (joint space) of the path; each simplified segment
+// is verified against the scene and waypoints are kept where it would collide
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int SetPathOutput(void* planner, const char* outputMode, double resolution);
+
+// Enable or disable corner blending of optimized paths
+// Each interior waypoint is replaced by a smooth blend of samplesPerBlend segments starting
+// blendRadius (joint space) before the corner; blends that collide are retried with a smaller
+// radius and otherwise keep the original corner. Smoothed paths have more waypoints.
+// blendRadius: >= 0 (0 disables smoothing); samplesPerBlend: >= 2
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int SetPathSmoothing(void* planner, double blendRadius, int samplesPerBlend);
+
+// Constrained planning: PlanTrajectory projects samples, extension steps and the goal onto the
+// manifold defined by the constraints below; configurations that cannot be projected are rejected,
+// and planning fails (RL_ERROR_PLANNING_FAILED) if 100 samples in a row cannot be projected;
+// constraints persist until ClearConstraints
+
+// Lock joint at value, or at its start configuration value if useStartValue is nonzero
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int AddLockedJointConstraint(void* planner, int jointIndex, double value, int useStartValue);
+
+// Couple joint linearly to reference joint: q[jointIndex] = ratio * q[referenceJointIndex] + offset
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int AddJointCouplingConstraint(void* planner, int jointIndex, int referenceJointIndex, double ratio, double offset);
+
+// Hold tool orientation during planning
+// orientation: target quaternion (qw, qx, qy, qz), or null to hold the start orientation
+// axisOnly: if nonzero only the tool z-axis direction is held, rotation about it stays free
+// tolerance: orientation error tolerance in radians, <= 0 uses the default (0.001)
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int SetToolOrientationConstraint(void* planner, const double* orientation, int axisOnly, double tolerance);
+
+// Remove all planning constraints
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int ClearConstraints(void* planner);
+
+// Build reachability map offline for the loaded robot and static scene
+// Samples collision-free configurations and voxelizes the reached tool positions, counting the
+// samples per voxel and approach direction (tool z-axis, 64 direction bins); the map is written to
+// outputPath and kept loaded in the planner instance. Samples are drawn with the seed of
+// SetRandomSeed (0 by default), so the same seed, scene and arguments give the same map
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int BuildReachabilityMap(void* planner, const char* outputPath, double voxelSize, int samples);
+
+// Load reachability map previously written by BuildReachabilityMap
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int LoadReachabilityMap(void* planner, const char* mapPath);
+
+// Check tool pose against the loaded reachability map
+// pose: x, y, z (position only) or x, y, z, qw, qx, qy, qz (poseSize 3 or 7)
+// The map is sampled: 0 means no sample reached the pose, not that it is unreachable
+// Returns 1 if reached by a sample, 0 if not, negative error code on failure (RL_ERROR_NOT_INITIALIZED if no map loaded)
+RL_PLANNER_API int IsPoseReachable(void* planner, const double* pose, int poseSize);
+
+// Get the reachability score of a tool pose (same layout as IsPoseReachable) from the loaded map
+// samples: output - collision-free samples that reached the pose's voxel and approach direction
+// (any approach direction for position-only poses)
+// orientations: output - approach direction bins reached in the pose's voxel, 0 to 64
+// Returns RL_SUCCESS (0) on success, negative error code on failure (RL_ERROR_NOT_INITIALIZED if no map loaded)
+RL_PLANNER_API int GetPoseReachability(void* planner, const double* pose, int poseSize, int* samples, int* orientations);
+
+// Plan trajectory to a tool pose (same layout as IsPoseReachable)
+// The goal configuration is found by inverse kinematics; goals reached in the loaded reachability
+// map get more inverse kinematics attempts, goals outside it are still tried
+// Other parameters and outputs as for PlanTrajectory
+// Returns RL_SUCCESS (0) on success, RL_ERROR_GOAL_UNREACHABLE if no collision-free inverse kinematics
+// solution is found, other negative error codes on failure
+RL_PLANNER_API int PlanTrajectoryToPose(
+    void* planner,
+    const double* start, int startSize,
+    const double* goalPose, int goalPoseSize,
+    const char* plannerType,
+    double delta, double epsilon, int timeoutMs,
+    double* waypoints, int maxWaypoints, int* waypointCount);
+
+// Enable or disable replanning mode
+// In replanning mode PlanTrajectory keeps a roadmap across queries and validates it lazily against
+// the current scene, so after a scene change only the parts of the roadmap that are searched are
+// re-checked and repaired; plans with active constraints use the regular planner
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int SetReplanningMode(void* planner, int enable);
+
+// Set the margin used by MoveSceneBody to find the roadmap vertices and edges a moved body affects
+// margin: distance in meters added around the robot body frames along each vertex and edge and
+// around the moved body's frame origin; should cover the extent of robot links and obstacles about
+// their frames (default 1.0). A smaller margin keeps stale cached results, which costs extra
+// searches but never a colliding path: the returned path is verified again at full resolution.
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int SetReplanningMargin(void* planner, double margin);
+
+// Move an obstacle body of the loaded scene without reloading it
+// pose: x, y, z (keeps orientation) or x, y, z, qw, qx, qy, qz (poseSize 3 or 7)
+// In replanning mode only roadmap vertices and edges within the replanning margin of the body's old
+// or new position are re-checked
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int MoveSceneBody(void* planner, int modelIndex, int bodyIndex, const double* pose, int poseSize);
+
+// Add another robot model of the loaded scene, without loading the scene again
+// Shares the scene of the planner instance; kinematicsXmlPath is the robot's kinematics file
+// The robot is planned together with the primary robot by PlanCoordinatedTrajectory, or on its own
+// through its context returned by GetRobotPlanner
+// Returns robot index (primary robot is 0, first added robot 1, ...), negative error code on failure
+RL_PLANNER_API int AddRobotModel(void* planner, const char* kinematicsXmlPath, int robotModelIndex);
+
+// Get number of robots of the planner instance (primary robot plus added robots)
+// Returns robot count, or negative error code on failure
+RL_PLANNER_API int GetRobotCount(void* planner);
+
+// Get planning context of a single robot (0 returns the planner instance itself)
+// The context shares scene and collision engine with the planner instance and can be used with
+// SetStart/GoalConfiguration, PlanTrajectory, IsValidConfiguration, GetDof and the planning options;
+// loading functions are rejected on it. During PlanTrajectory the other robots are obstacles at
+// their stored start configurations. Contexts of one planner instance must not be used concurrently.
+// The context is owned by the planner instance; DestroyPlanner on it has no effect.
+// LoadScene and LoadPlanXml remove the added robots: their contexts stay allocated until the planner
+// instance is destroyed, but every call that needs the robot returns RL_ERROR_NOT_INITIALIZED.
+// Returns context handle, or null on failure
+RL_PLANNER_API void* GetRobotPlanner(void* planner, int robotIndex);
+
+// Plan coordinated trajectories for the primary robot and all added robots (prioritized planning)
+// Each robot's path is planned and then scheduled against the time-indexed paths of the robots
+// before it, waiting where needed to avoid robot-robot collisions
+// starts, goals: composite configurations (robot configurations concatenated in robot index order)
+// waypoints: output buffer of composite configurations per time step (waypointCount * total DOF values),
+// consecutive time steps are at most delta apart for each robot
+// waypointCount: output - number of time steps
+// Returns RL_SUCCESS (0) on success, RL_ERROR_BUFFER_TOO_SMALL if there are more than
+// maxWaypoints time steps, negative error code on failure
+// On RL_ERROR_BUFFER_TOO_SMALL only the first maxWaypoints time steps are written and waypointCount
+// is the full count; calling again with that many plans anew
+RL_PLANNER_API int PlanCoordinatedTrajectory(
+    void* planner,
+    const double* starts, int startsSize,
+    const double* goals, int goalsSize,
+    const char* plannerType,
+    double delta, double epsilon, int timeoutMs,
+    double* waypoints, int maxWaypoints, int* waypointCount);
+
+// Set per-joint limits for time parameterization, overriding the limits set by LoadKinematics
+// (speed element of each joint in the kinematics XML, default 1; acceleration twice the speed;
+// jerk unlimited)
+// maxJerk may be null; jerk limits <= 0 are unlimited
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int SetJointLimits(void* planner, const double* maxVelocity, const double* maxAcceleration, const double* maxJerk, int dof);
+
+// Time-optimal parameterization of a path (e.g. PlanTrajectory output) under the joint limits,
+// starting and ending at rest
+// timestamps: output buffer with the time of each waypoint in seconds (waypointCount values)
+// Returns RL_SUCCESS (0) on success, RL_ERROR_PLANNING_FAILED if the limits cannot be met (jerk
+// limits included), negative error code on failure
+RL_PLANNER_API int TimeParameterizePath(void* planner, const double* waypoints, int waypointCount, double* timestamps);
+
+// Time-optimal trajectory along a path sampled every sampleTime seconds
+// positions: output buffer (sampleCount * dof values); velocities: output buffer of the same size, or null
+// sampleCount: output - number of samples of the trajectory
+// Returns RL_SUCCESS (0) on success, RL_ERROR_BUFFER_TOO_SMALL if there are more than
+// maxSamples samples, RL_ERROR_PLANNING_FAILED if the limits cannot be met (jerk limits included),
+// negative error code on failure
+// On RL_ERROR_BUFFER_TOO_SMALL only the first maxSamples samples are written and sampleCount is
+// the full count, which a call with the same waypoints and sampleTime fits
+RL_PLANNER_API int SampleTrajectory(
+    void* planner,
+    const double* waypoints, int waypointCount,
+    double sampleTime,
+    double* positions, double* velocities, int maxSamples, int* sampleCount);
+
+// Compute quality metrics of one or many paths, in parallel across paths
+// waypoints: all paths concatenated (sum of waypointCounts * dof values)
+// waypointCounts: number of waypoints of each path (pathCount values)
+// threadCount: > 0, or 0 for one thread per hardware thread; additional threads load the scene once
+// metrics: output buffer, RL_PATH_METRIC_COUNT values per path (pathCount * RL_PATH_METRIC_COUNT):
+//   RL_PATH_METRIC_LENGTH: joint space length
+//   RL_PATH_METRIC_MIN_CLEARANCE: minimum distance to obstacles at samples delta apart,
+//     -1 if the collision engine has no distance queries (ODE)
+//   RL_PATH_METRIC_JOINT_REVERSALS: number of direction changes summed over all joints
+//   RL_PATH_METRIC_DURATION: time-optimal duration under the joint limits (see TimeParameterizePath)
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int EvaluatePathMetrics(
+    void* planner,
+    const double* waypoints, const int* waypointCounts, int pathCount,
+    int threadCount, double* metrics);
+
 // Check if configuration is collision-free (uses loaded scene)
 // Returns 1 if valid (collision-free and within joint limits), 0 if invalid
 RL_PLANNER_API int IsValidConfiguration(void* planner, const double* config, int configSize);
 
+// Check the straight joint-space segment between two configurations with the planner's verifier
+// (joint limits, both endpoints and interior configurations at the verifier resolution)
+// Returns 1 if collision-free, 0 if not, negative error code on failure
+RL_PLANNER_API int IsValidSegment(void* planner, const double* from, const double* to, int configSize);
+
+// Compute the tool pose of a configuration
+// pose: output - x, y, z (poseSize 3) or x, y, z, qw, qx, qy, qz (poseSize 7), as for IsPoseReachable
+// Returns RL_SUCCESS (0) on success, negative error code on failure
+RL_PLANNER_API int ForwardKinematics(void* planner, const double* config, int configSize, double* pose, int poseSize);
+
 // Get degrees of freedom (number of joints)
 // Returns DOF count, or negative error code on failure
 RL_PLANNER_API int GetDof(void* planner);
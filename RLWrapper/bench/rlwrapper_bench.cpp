@@ -0,0 +1,354 @@
+//
+// rlwrapper_bench.cpp
+// Micro-benchmarks for the RLWrapper C API and the rl structures it builds on
+//
+// Usage: rlwrapper_bench --plan=<plan.xml> [--plan=<plan.xml> ...] [--timeout=<ms>] [benchmark options]
+// Each plan XML (as parsed by LoadPlanXml) registers one set of benchmarks named after the file.
+//
+
+#include "RLWrapper.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <rl/kin/Kinematics.h>
+#include <rl/math/Vector.h>
+#include <rl/mdl/XmlFactory.h>
+#include <rl/plan/KdtreeNearestNeighbors.h>
+#include <rl/plan/LinearNearestNeighbors.h>
+#include <rl/plan/SimpleModel.h>
+#include <rl/xml/Document.h>
+#include <rl/xml/DomParser.h>
+#include <rl/xml/Path.h>
+
+// Reference plan loaded once and shared by its benchmarks
+struct ReferencePlan
+{
+    ReferencePlan() : name(), path(), planner(nullptr), dof(0), waypoints(), from(), to(), kinematicsPath() {}
+    
+    ~ReferencePlan()
+    {
+        if (planner)
+        {
+            DestroyPlanner(planner);
+        }
+    }
+    
+    std::string name;
+    
+    std::string path;
+    
+    void* planner;
+    
+    int dof;
+    
+    // Path planned during setup, a source of valid configurations
+    std::vector<double> waypoints;
+    
+    // Longest segment of the planned path
+    std::vector<double> from;
+    
+    std::vector<double> to;
+    
+    std::string kinematicsPath;
+};
+
+static int planTimeoutMs = 30000;
+
+// Helper function to plan a reference path with the stored start and goal of a plan
+static int planReference(void* planner, int dof, std::vector<double>& waypoints)
+{
+    void* handle = nullptr;
+    
+    int result = PlanTrajectoryResult(planner, nullptr, 0, nullptr, 0, 0, nullptr, 0, 0, planTimeoutMs, &handle);
+    
+    waypoints.clear();
+    
+    if (RL_SUCCESS == result)
+    {
+        const double* data = nullptr;
+        int stride = 0;
+        int count = 0;
+        result = GetPathResult(handle, &data, &stride, &count);
+        if (RL_SUCCESS == result && (stride != dof || count <= 0))
+        {
+            result = RL_ERROR_PLANNING_FAILED;
+        }
+        if (RL_SUCCESS == result)
+        {
+            waypoints.assign(data, data + static_cast<std::size_t>(count) * stride);
+        }
+    }
+    
+    ReleasePathResult(handle);
+    return result;
+}
+
+// Helper function to read the kinematics file referenced by a plan XML
+static std::string readKinematicsPath(const std::string& planPath)
+{
+    rl::xml::DomParser parser;
+    rl::xml::Document document = parser.readFile(planPath, "", XML_PARSE_NOENT | XML_PARSE_XINCLUDE);
+    document.substitute(XML_PARSE_NOENT | XML_PARSE_XINCLUDE);
+    
+    rl::xml::Path path(document);
+    rl::xml::NodeSet kinematics = path.eval("(/rl/plan|/rlplan)//model/kinematics").getValue<rl::xml::NodeSet>();
+    if (kinematics.empty())
+    {
+        return std::string();
+    }
+    
+    return kinematics[0].getLocalPath(kinematics[0].getProperty("href"));
+}
+
+static bool loadReferencePlan(ReferencePlan& plan)
+{
+    plan.planner = CreatePlanner();
+    if (!plan.planner || RL_SUCCESS != LoadPlanXml(plan.planner, plan.path.c_str()))
+    {
+        std::cerr << "rlwrapper_bench: Failed to load plan: " << plan.path << std::endl;
+        return false;
+    }
+    
+    plan.dof = GetDof(plan.planner);
+    if (plan.dof <= 0 || RL_SUCCESS != planReference(plan.planner, plan.dof, plan.waypoints))
+    {
+        std::cerr << "rlwrapper_bench: Failed to plan reference path for: " << plan.path << std::endl;
+        return false;
+    }
+    
+    std::size_t count = plan.waypoints.size() / plan.dof;
+    std::size_t longest = 0;
+    double longestLength = -1;
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        double length = 0;
+        for (int j = 0; j < plan.dof; ++j)
+        {
+            double d = plan.waypoints[i * plan.dof + j] - plan.waypoints[(i - 1) * plan.dof + j];
+            length += d * d;
+        }
+        if (length > longestLength)
+        {
+            longest = i;
+            longestLength = length;
+        }
+    }
+    
+    std::size_t first = longest > 0 ? longest - 1 : 0;
+    plan.from.assign(plan.waypoints.begin() + first * plan.dof, plan.waypoints.begin() + (first + 1) * plan.dof);
+    plan.to.assign(plan.waypoints.begin() + longest * plan.dof, plan.waypoints.begin() + (longest + 1) * plan.dof);
+    
+    try
+    {
+        plan.kinematicsPath = readKinematicsPath(plan.path);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "rlwrapper_bench: Could not read kinematics of " << plan.path << ": " << e.what() << std::endl;
+    }
+    
+    return true;
+}
+
+static void benchIsValidConfiguration(benchmark::State& state, ReferencePlan* plan)
+{
+    std::size_t count = plan->waypoints.size() / plan->dof;
+    std::size_t i = 0;
+    
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(IsValidConfiguration(plan->planner, &plan->waypoints[(i % count) * plan->dof], plan->dof));
+        ++i;
+    }
+}
+
+static void benchIsValidSegment(benchmark::State& state, ReferencePlan* plan)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(IsValidSegment(plan->planner, plan->from.data(), plan->to.data(), plan->dof));
+    }
+}
+
+static void benchForwardKinematics(benchmark::State& state, ReferencePlan* plan)
+{
+    std::size_t count = plan->waypoints.size() / plan->dof;
+    std::size_t i = 0;
+    double pose[7];
+    
+    for (auto _ : state)
+    {
+        ForwardKinematics(plan->planner, &plan->waypoints[(i % count) * plan->dof], plan->dof, pose, 7);
+        benchmark::DoNotOptimize(pose);
+        ++i;
+    }
+}
+
+// Nearest neighbor queries of uniformly sampled configurations against a tree of state.range(0) vertices,
+// with the distance metric of the plan's kinematics
+static void benchNearestNeighbors(benchmark::State& state, ReferencePlan* plan, bool kdtree)
+{
+    std::shared_ptr<rl::mdl::Model> mdl;
+    std::shared_ptr<rl::kin::Kinematics> kinematics;
+    rl::plan::SimpleModel model;
+    
+    try
+    {
+        rl::mdl::XmlFactory factory;
+        mdl = factory.create(plan->kinematicsPath);
+        model.mdl = mdl.get();
+    }
+    catch (const std::exception&)
+    {
+        kinematics = std::shared_ptr<rl::kin::Kinematics>(rl::kin::Kinematics::create(plan->kinematicsPath));
+        model.kin = kinematics.get();
+    }
+    
+    std::unique_ptr<rl::plan::NearestNeighbors> nearestNeighbors;
+    if (kdtree)
+    {
+        nearestNeighbors.reset(new rl::plan::KdtreeNearestNeighbors(&model));
+    }
+    else
+    {
+        nearestNeighbors.reset(new rl::plan::LinearNearestNeighbors(&model));
+    }
+    
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<rl::math::Real> distribution(0, 1);
+    rl::math::Vector rand(plan->dof);
+    
+    // Vertices are referenced by the structure and must not move
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<rl::math::Vector> vertices(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        for (int j = 0; j < plan->dof; ++j)
+        {
+            rand(j) = distribution(engine);
+        }
+        vertices[i] = model.generatePositionUniform(rand);
+        nearestNeighbors->push(rl::plan::NearestNeighbors::Value(&vertices[i], i));
+    }
+    
+    std::vector<rl::math::Vector> queries(256);
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        for (int j = 0; j < plan->dof; ++j)
+        {
+            rand(j) = distribution(engine);
+        }
+        queries[i] = model.generatePositionUniform(rand);
+    }
+    
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(nearestNeighbors->nearest(queries[i % queries.size()], 1));
+        ++i;
+    }
+}
+
+static void benchPlanTrajectory(benchmark::State& state, ReferencePlan* plan)
+{
+    std::vector<double> waypoints;
+    double collisionChecks = 0;
+    double failures = 0;
+    
+    for (auto _ : state)
+    {
+        if (RL_SUCCESS != planReference(plan->planner, plan->dof, waypoints))
+        {
+            ++failures;
+        }
+        
+        RL_PlanStats stats;
+        GetLastPlanStats(plan->planner, &stats);
+        collisionChecks += static_cast<double>(stats.collisionChecks);
+    }
+    
+    state.counters["collision_checks"] = benchmark::Counter(collisionChecks, benchmark::Counter::kAvgIterations);
+    state.counters["failures"] = benchmark::Counter(failures);
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::unique_ptr<ReferencePlan>> plans;
+    std::vector<char*> arguments;
+    
+    // Own options are removed before the benchmark library parses the rest
+    for (int i = 0; i < argc; ++i)
+    {
+        if (0 == std::strncmp(argv[i], "--plan=", 7))
+        {
+            std::unique_ptr<ReferencePlan> plan(new ReferencePlan());
+            plan->path = argv[i] + 7;
+            std::size_t slash = plan->path.find_last_of("/\\");
+            plan->name = (std::string::npos == slash) ? plan->path : plan->path.substr(slash + 1);
+            plans.push_back(std::move(plan));
+        }
+        else if (0 == std::strncmp(argv[i], "--timeout=", 10))
+        {
+            planTimeoutMs = std::max(1, std::atoi(argv[i] + 10));
+        }
+        else
+        {
+            arguments.push_back(argv[i]);
+        }
+    }
+    
+    if (plans.empty())
+    {
+        std::cerr << "Usage: rlwrapper_bench --plan=<plan.xml> [--plan=<plan.xml> ...] [--timeout=<ms>] [benchmark options]" << std::endl;
+        return 1;
+    }
+    
+    SetLogLevel(RL_LOG_LEVEL_WARNING);
+    
+    for (std::size_t i = 0; i < plans.size(); ++i)
+    {
+        ReferencePlan* plan = plans[i].get();
+        if (!loadReferencePlan(*plan))
+        {
+            return 1;
+        }
+        
+        benchmark::RegisterBenchmark(("IsValidConfiguration/" + plan->name).c_str(), benchIsValidConfiguration, plan);
+        benchmark::RegisterBenchmark(("IsValidSegment/" + plan->name).c_str(), benchIsValidSegment, plan);
+        benchmark::RegisterBenchmark(("ForwardKinematics/" + plan->name).c_str(), benchForwardKinematics, plan);
+        
+        if (!plan->kinematicsPath.empty())
+        {
+            benchmark::RegisterBenchmark(("LinearNearestNeighbors/" + plan->name).c_str(), benchNearestNeighbors, plan, false)
+                ->RangeMultiplier(10)->Range(100, 100000);
+            benchmark::RegisterBenchmark(("KdtreeNearestNeighbors/" + plan->name).c_str(), benchNearestNeighbors, plan, true)
+                ->RangeMultiplier(10)->Range(100, 100000);
+        }
+        
+        benchmark::RegisterBenchmark(("PlanTrajectory/" + plan->name).c_str(), benchPlanTrajectory, plan)
+            ->Unit(benchmark::kMillisecond)->UseRealTime();
+    }
+    
+    int count = static_cast<int>(arguments.size());
+    arguments.push_back(nullptr);
+    benchmark::Initialize(&count, arguments.data());
+    if (benchmark::ReportUnrecognizedArguments(count, arguments.data()))
+    {
+        return 1;
+    }
+    
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    FlushLog();
+    
+    return 0;
+}
@@ -0,0 +1,344 @@
+//
+// ToolSupport.cpp
+// Shared helpers of the RLWrapper command-line tools
+//
+
+#include "ToolSupport.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "RLWrapper.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+namespace rlwrapper
+{
+    Options::Options(int argc, char** argv) :
+        values()
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string argument = argv[i];
+            if (argument.compare(0, 2, "--") != 0)
+            {
+                continue;
+            }
+            
+            std::size_t equals = argument.find('=');
+            if (std::string::npos == equals)
+            {
+                values.push_back(std::make_pair(argument.substr(2), std::string("1")));
+            }
+            else
+            {
+                values.push_back(std::make_pair(argument.substr(2, equals - 2), argument.substr(equals + 1)));
+            }
+        }
+    }
+    
+    bool Options::has(const std::string& name) const
+    {
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            if (values[i].first == name)
+            {
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    std::string Options::get(const std::string& name, const std::string& defaultValue) const
+    {
+        // Later options override earlier ones
+        for (std::size_t i = values.size(); i > 0; --i)
+        {
+            if (values[i - 1].first == name)
+            {
+                return values[i - 1].second;
+            }
+        }
+        
+        return defaultValue;
+    }
+    
+    int Options::getInt(const std::string& name, int defaultValue) const
+    {
+        return has(name) ? std::atoi(get(name, "").c_str()) : defaultValue;
+    }
+    
+    double Options::getDouble(const std::string& name, double defaultValue) const
+    {
+        return has(name) ? std::atof(get(name, "").c_str()) : defaultValue;
+    }
+    
+    std::vector<std::string> Options::getList(const std::string& name, const std::string& defaultValue) const
+    {
+        std::vector<std::string> list;
+        std::stringstream stream(get(name, defaultValue));
+        std::string item;
+        
+        while (std::getline(stream, item, ','))
+        {
+            if (!item.empty())
+            {
+                list.push_back(item);
+            }
+        }
+        
+        return list;
+    }
+    
+    std::vector<int> Options::getIntList(const std::string& name, const std::string& defaultValue) const
+    {
+        std::vector<std::string> items = getList(name, defaultValue);
+        std::vector<int> list;
+        
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            list.push_back(std::atoi(items[i].c_str()));
+        }
+        
+        return list;
+    }
+    
+    std::vector<std::string> listPlanFiles(const std::string& directory)
+    {
+        std::vector<std::string> files;
+
+#ifdef _WIN32
+        WIN32_FIND_DATAA data;
+        HANDLE handle = FindFirstFileA((directory + "\\*.xml").c_str(), &data);
+        if (INVALID_HANDLE_VALUE != handle)
+        {
+            do
+            {
+                if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+                {
+                    files.push_back(directory + "\\" + data.cFileName);
+                }
+            }
+            while (FindNextFileA(handle, &data));
+            
+            FindClose(handle);
+        }
+#else
+        DIR* dir = opendir(directory.c_str());
+        if (dir)
+        {
+            while (struct dirent* entry = readdir(dir))
+            {
+                std::string name = entry->d_name;
+                if (name.size() > 4 && 0 == name.compare(name.size() - 4, 4, ".xml"))
+                {
+                    files.push_back(directory + "/" + name);
+                }
+            }
+            
+            closedir(dir);
+        }
+#endif
+
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+    
+    std::string baseName(const std::string& path)
+    {
+        std::size_t slash = path.find_last_of("/\\");
+        return (std::string::npos == slash) ? path : path.substr(slash + 1);
+    }
+    
+    std::vector<PlanQuery> readQueries(const std::string& planPath, int dof)
+    {
+        std::vector<PlanQuery> queries;
+        
+        std::string queryPath = planPath.substr(0, planPath.size() - (planPath.size() > 4 ? 4 : 0)) + ".queries";
+        std::ifstream file(queryPath.c_str());
+        std::string line;
+        
+        while (std::getline(file, line))
+        {
+            line = line.substr(0, line.find('#'));
+            
+            std::size_t separator = line.find(';');
+            if (std::string::npos == separator)
+            {
+                continue;
+            }
+            
+            PlanQuery query;
+            std::stringstream start(line.substr(0, separator));
+            std::stringstream goal(line.substr(separator + 1));
+            double value;
+            
+            while (start >> value)
+            {
+                query.start.push_back(value);
+            }
+            while (goal >> value)
+            {
+                query.goal.push_back(value);
+            }
+            
+            if (static_cast<int>(query.start.size()) == dof && static_cast<int>(query.goal.size()) == dof)
+            {
+                queries.push_back(query);
+            }
+            else
+            {
+                std::fprintf(stderr, "%s: Ignoring query with wrong DOF: %s\n", queryPath.c_str(), line.c_str());
+            }
+        }
+        
+        if (queries.empty())
+        {
+            queries.push_back(PlanQuery());
+        }
+        
+        return queries;
+    }
+    
+    double pathLength(const double* waypoints, int count, int dof)
+    {
+        double length = 0;
+        
+        for (int i = 1; i < count; ++i)
+        {
+            double squared = 0;
+            for (int j = 0; j < dof; ++j)
+            {
+                double d = waypoints[i * dof + j] - waypoints[(i - 1) * dof + j];
+                squared += d * d;
+            }
+            length += std::sqrt(squared);
+        }
+        
+        return length;
+    }
+    
+    double quantile(std::vector<double> values, double q)
+    {
+        if (values.empty())
+        {
+            return 0;
+        }
+        
+        std::size_t rank = static_cast<std::size_t>(std::ceil(q * values.size()));
+        std::size_t index = std::min(values.size() - 1, rank > 0 ? rank - 1 : 0);
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        
+        return values[index];
+    }
+    
+    std::string jsonString(const std::string& value)
+    {
+        std::string result = "\"";
+        
+        for (std::size_t i = 0; i < value.size(); ++i)
+        {
+            char c = value[i];
+            if ('"' == c || '\\' == c)
+            {
+                result += '\\';
+                result += c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                result += escaped;
+            }
+            else
+            {
+                result += c;
+            }
+        }
+        
+        return result + "\"";
+    }
+    
+    std::string csvField(const std::string& value)
+    {
+        if (std::string::npos == value.find_first_of(",\"\n"))
+        {
+            return value;
+        }
+        
+        std::string result = "\"";
+        for (std::size_t i = 0; i < value.size(); ++i)
+        {
+            if ('"' == value[i])
+            {
+                result += '"';
+            }
+            result += value[i];
+        }
+        
+        return result + "\"";
+    }
+    
+    long long residentMemoryBytes()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        {
+            return static_cast<long long>(counters.WorkingSetSize);
+        }
+        return -1;
+#else
+        // Second field of /proc/self/statm: resident pages (Linux only)
+        long long size = 0;
+        long long resident = 0;
+        std::FILE* file = std::fopen("/proc/self/statm", "r");
+        if (!file)
+        {
+            return -1;
+        }
+        int fields = std::fscanf(file, "%lld %lld", &size, &resident);
+        std::fclose(file);
+        
+        return 2 == fields ? resident * static_cast<long long>(sysconf(_SC_PAGESIZE)) : -1;
+#endif
+    }
+    
+    int planQuery(void* planner, const PlanQuery& query, int dof, const char* plannerType, int timeoutMs, std::vector<double>& waypoints)
+    {
+        void* handle = nullptr;
+        
+        int result = PlanTrajectoryResult(planner,
+            query.start.empty() ? nullptr : query.start.data(), static_cast<int>(query.start.size()),
+            query.goal.empty() ? nullptr : query.goal.data(), static_cast<int>(query.goal.size()),
+            0, plannerType, 0, 0, timeoutMs, &handle);
+        
+        waypoints.clear();
+        
+        if (RL_SUCCESS == result)
+        {
+            const double* data = nullptr;
+            int stride = 0;
+            int count = 0;
+            result = GetPathResult(handle, &data, &stride, &count);
+            if (RL_SUCCESS == result && stride == dof)
+            {
+                waypoints.assign(data, data + static_cast<std::size_t>(count) * stride);
+            }
+        }
+        
+        ReleasePathResult(handle);
+        return result;
+    }
+}
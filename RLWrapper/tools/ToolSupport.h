@@ -0,0 +1,76 @@
+//
+// ToolSupport.h
+// Shared helpers of the RLWrapper command-line tools
+//
+
+#ifndef RL_WRAPPER_TOOL_SUPPORT_H
+#define RL_WRAPPER_TOOL_SUPPORT_H
+
+#include <string>
+#include <vector>
+
+namespace rlwrapper
+{
+    // Start/goal pair of a plan; empty vectors use the start/goal stored in the plan XML
+    struct PlanQuery
+    {
+        std::vector<double> start;
+        
+        std::vector<double> goal;
+    };
+    
+    // Command-line options of the form --name=value
+    class Options
+    {
+    public:
+        Options(int argc, char** argv);
+        
+        bool has(const std::string& name) const;
+        
+        std::string get(const std::string& name, const std::string& defaultValue) const;
+        
+        int getInt(const std::string& name, int defaultValue) const;
+        
+        double getDouble(const std::string& name, double defaultValue) const;
+        
+        // Comma-separated list
+        std::vector<std::string> getList(const std::string& name, const std::string& defaultValue) const;
+        
+        std::vector<int> getIntList(const std::string& name, const std::string& defaultValue) const;
+    
+    private:
+        std::vector<std::pair<std::string, std::string>> values;
+    };
+    
+    // Plan XML files (*.xml) of a directory, sorted by name
+    std::vector<std::string> listPlanFiles(const std::string& directory);
+    
+    // File name without directory
+    std::string baseName(const std::string& path);
+    
+    // Queries of a plan: <plan>.queries next to the plan file, one query per line as
+    // start joint values (radians), ';', goal joint values; '#' starts a comment.
+    // Without a query file the plan's own start/goal is the only query.
+    std::vector<PlanQuery> readQueries(const std::string& planPath, int dof);
+    
+    // Joint-space length of a flattened path of count waypoints
+    double pathLength(const double* waypoints, int count, int dof);
+    
+    // Quantile of values by nearest rank, 0 for an empty set
+    double quantile(std::vector<double> values, double q);
+    
+    // JSON string literal
+    std::string jsonString(const std::string& value);
+    
+    // CSV field, quoted if needed
+    std::string csvField(const std::string& value);
+    
+    // Resident set size of the process in bytes, -1 where not supported
+    long long residentMemoryBytes();
+    
+    // Plan a query with PlanTrajectoryResult, copying the path into waypoints (flattened, dof values per waypoint)
+    // Returns the result code of the planning call
+    int planQuery(void* planner, const PlanQuery& query, int dof, const char* plannerType, int timeoutMs, std::vector<double>& waypoints);
+}
+
+#endif // RL_WRAPPER_TOOL_SUPPORT_H
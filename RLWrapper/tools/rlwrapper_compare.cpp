@@ -0,0 +1,342 @@
+//
+// rlwrapper_compare.cpp
+// Planner comparison on one scene: success probability over time and path cost distributions
+//
+// Usage: rlwrapper_compare --plan=<plan.xml> [--planners=rrt,rrtConCon,rrtGoalBias,prm] [--trials=100]
+//                          [--seed=1] [--timeout=10000] [--points=50] [--json=<file>]
+//                          [--trials-csv=<file>] [--curve-csv=<file>]
+// Trial i of every planner type uses seed + i (SetRandomSeed) and query i of the plan's queries
+// (see readQueries), so all planner types see the same sequence of problems. Trials run one at a
+// time on a single planner instance per type to keep timings free of contention.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "RLWrapper.h"
+#include "ToolSupport.h"
+
+// Outcome of one seeded trial
+struct Trial
+{
+    unsigned int seed;
+    
+    bool success;
+    
+    double timeMs;
+    
+    double metrics[RL_PATH_METRIC_COUNT];
+};
+
+struct PlannerTrials
+{
+    std::string planner;
+    
+    std::vector<Trial> trials;
+};
+
+static bool runTrials(const std::string& planPath, const std::string& plannerType, int trialCount, unsigned int seed, int timeoutMs, PlannerTrials& result)
+{
+    void* planner = CreatePlanner();
+    if (!planner || RL_SUCCESS != LoadPlanXml(planner, planPath.c_str()))
+    {
+        std::cerr << "rlwrapper_compare: Failed to load plan: " << planPath << std::endl;
+        DestroyPlanner(planner);
+        return false;
+    }
+    
+    int dof = GetDof(planner);
+    std::vector<rlwrapper::PlanQuery> queries = rlwrapper::readQueries(planPath, dof);
+    std::vector<double> waypoints;
+    std::vector<double> paths;
+    std::vector<int> counts;
+    
+    result.planner = plannerType;
+    
+    for (int i = 0; i < trialCount; ++i)
+    {
+        Trial trial;
+        trial.seed = seed + static_cast<unsigned int>(i);
+        std::fill(trial.metrics, trial.metrics + RL_PATH_METRIC_COUNT, 0.0);
+        
+        SetRandomSeed(planner, trial.seed);
+        
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        int code = rlwrapper::planQuery(planner, queries[i % queries.size()], dof, plannerType.c_str(), timeoutMs, waypoints);
+        trial.timeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        trial.success = (RL_SUCCESS == code);
+        
+        if (trial.success)
+        {
+            paths.insert(paths.end(), waypoints.begin(), waypoints.end());
+            counts.push_back(static_cast<int>(waypoints.size()) / dof);
+        }
+        
+        result.trials.push_back(trial);
+    }
+    
+    // Path costs of all successful trials in one batch
+    if (!counts.empty())
+    {
+        std::vector<double> metrics(counts.size() * RL_PATH_METRIC_COUNT);
+        if (RL_SUCCESS == EvaluatePathMetrics(planner, paths.data(), counts.data(), static_cast<int>(counts.size()), 0, metrics.data()))
+        {
+            std::size_t path = 0;
+            for (std::size_t i = 0; i < result.trials.size(); ++i)
+            {
+                if (result.trials[i].success)
+                {
+                    std::copy(metrics.begin() + path * RL_PATH_METRIC_COUNT, metrics.begin() + (path + 1) * RL_PATH_METRIC_COUNT, result.trials[i].metrics);
+                    ++path;
+                }
+            }
+        }
+    }
+    
+    DestroyPlanner(planner);
+    return true;
+}
+
+// Fraction of all trials solved within timeMs
+static double successProbability(const PlannerTrials& result, double timeMs)
+{
+    std::size_t solved = 0;
+    
+    for (std::size_t i = 0; i < result.trials.size(); ++i)
+    {
+        if (result.trials[i].success && result.trials[i].timeMs <= timeMs)
+        {
+            ++solved;
+        }
+    }
+    
+    return result.trials.empty() ? 0 : static_cast<double>(solved) / result.trials.size();
+}
+
+// Smallest time by which the given fraction of all trials is solved, negative if never reached
+static double timeToProbability(const PlannerTrials& result, double probability)
+{
+    std::vector<double> times;
+    for (std::size_t i = 0; i < result.trials.size(); ++i)
+    {
+        if (result.trials[i].success)
+        {
+            times.push_back(result.trials[i].timeMs);
+        }
+    }
+    std::sort(times.begin(), times.end());
+    
+    std::size_t needed = static_cast<std::size_t>(std::ceil(probability * result.trials.size()));
+    if (0 == needed || needed > times.size())
+    {
+        return needed > times.size() ? -1 : 0;
+    }
+    
+    return times[needed - 1];
+}
+
+// Log-spaced time points from 1 ms to the timeout
+static std::vector<double> curveTimes(int timeoutMs, int points)
+{
+    std::vector<double> times;
+    double last = std::max(1, timeoutMs);
+    
+    for (int i = 0; i < points; ++i)
+    {
+        times.push_back(points > 1 ? std::pow(last, static_cast<double>(i) / (points - 1)) : last);
+    }
+    
+    return times;
+}
+
+static void writeDistribution(std::ostream& out, const std::vector<double>& values)
+{
+    double sum = 0;
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        sum += values[i];
+    }
+    
+    out << "{\"count\": " << values.size()
+        << ", \"mean\": " << (values.empty() ? 0 : sum / values.size())
+        << ", \"min\": " << rlwrapper::quantile(values, 0)
+        << ", \"p25\": " << rlwrapper::quantile(values, 0.25)
+        << ", \"p50\": " << rlwrapper::quantile(values, 0.5)
+        << ", \"p75\": " << rlwrapper::quantile(values, 0.75)
+        << ", \"p90\": " << rlwrapper::quantile(values, 0.9)
+        << ", \"max\": " << rlwrapper::quantile(values, 1) << "}";
+}
+
+static void writeJson(std::ostream& out, const std::string& plan, const std::vector<PlannerTrials>& results, const std::vector<double>& times)
+{
+    const double probabilities[] = { 0.5, 0.9, 0.95, 0.99 };
+    const char* const metricNames[] = { "length", "min_clearance", "joint_reversals", "duration" };
+    
+    out << std::setprecision(10) << "{\n  \"plan\": " << rlwrapper::jsonString(plan) << ",\n  \"planners\": [";
+    
+    for (std::size_t k = 0; k < results.size(); ++k)
+    {
+        const PlannerTrials& result = results[k];
+        std::size_t successes = 0;
+        for (std::size_t i = 0; i < result.trials.size(); ++i)
+        {
+            successes += result.trials[i].success ? 1 : 0;
+        }
+        
+        out << (k > 0 ? "," : "") << "\n    {\n      \"planner\": " << rlwrapper::jsonString(result.planner)
+            << ",\n      \"trials\": " << result.trials.size()
+            << ",\n      \"successes\": " << successes
+            << ",\n      \"time_to_success_probability_ms\": {";
+        
+        for (std::size_t p = 0; p < sizeof(probabilities) / sizeof(probabilities[0]); ++p)
+        {
+            double time = timeToProbability(result, probabilities[p]);
+            out << (p > 0 ? ", " : "") << "\"" << probabilities[p] << "\": ";
+            if (time < 0)
+            {
+                out << "null";
+            }
+            else
+            {
+                out << time;
+            }
+        }
+        
+        out << "},\n      \"success_curve\": [";
+        for (std::size_t t = 0; t < times.size(); ++t)
+        {
+            out << (t > 0 ? ", " : "") << "[" << times[t] << ", " << successProbability(result, times[t]) << "]";
+        }
+        out << "],\n      \"path_cost\": {";
+        
+        for (int m = 0; m < RL_PATH_METRIC_COUNT; ++m)
+        {
+            std::vector<double> values;
+            for (std::size_t i = 0; i < result.trials.size(); ++i)
+            {
+                if (result.trials[i].success)
+                {
+                    values.push_back(result.trials[i].metrics[m]);
+                }
+            }
+            
+            out << (m > 0 ? ", " : "") << "\"" << metricNames[m] << "\": ";
+            writeDistribution(out, values);
+        }
+        
+        out << "}\n    }";
+    }
+    
+    out << "\n  ]\n}\n";
+}
+
+static void writeTrialsCsv(std::ostream& out, const std::vector<PlannerTrials>& results)
+{
+    out << std::setprecision(10) << "planner,trial,seed,success,time_ms,length,min_clearance,joint_reversals,duration\n";
+    
+    for (std::size_t k = 0; k < results.size(); ++k)
+    {
+        for (std::size_t i = 0; i < results[k].trials.size(); ++i)
+        {
+            const Trial& trial = results[k].trials[i];
+            out << rlwrapper::csvField(results[k].planner) << "," << i << "," << trial.seed << "," << (trial.success ? 1 : 0) << "," << trial.timeMs;
+            for (int m = 0; m < RL_PATH_METRIC_COUNT; ++m)
+            {
+                out << "," << trial.metrics[m];
+            }
+            out << "\n";
+        }
+    }
+}
+
+static void writeCurveCsv(std::ostream& out, const std::vector<PlannerTrials>& results, const std::vector<double>& times)
+{
+    out << std::setprecision(10) << "planner,time_ms,success_probability\n";
+    
+    for (std::size_t k = 0; k < results.size(); ++k)
+    {
+        for (std::size_t t = 0; t < times.size(); ++t)
+        {
+            out << rlwrapper::csvField(results[k].planner) << "," << times[t] << "," << successProbability(results[k], times[t]) << "\n";
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    rlwrapper::Options options(argc, argv);
+    
+    if (!options.has("plan"))
+    {
+        std::cerr << "Usage: rlwrapper_compare --plan=<plan.xml> [--planners=rrt,rrtConCon,rrtGoalBias,prm] [--trials=100]" << std::endl
+                  << "                         [--seed=1] [--timeout=10000] [--points=50] [--json=<file>]" << std::endl
+                  << "                         [--trials-csv=<file>] [--curve-csv=<file>]" << std::endl;
+        return 1;
+    }
+    
+    std::string plan = options.get("plan", "");
+    std::vector<std::string> planners = options.getList("planners", "rrt,rrtConCon,rrtGoalBias,prm");
+    int trials = std::max(1, options.getInt("trials", 100));
+    unsigned int seed = static_cast<unsigned int>(options.getInt("seed", 1));
+    int timeoutMs = std::max(1, options.getInt("timeout", 10000));
+    std::vector<double> times = curveTimes(timeoutMs, std::max(2, options.getInt("points", 50)));
+    
+    SetLogLevel(RL_LOG_LEVEL_WARNING);
+    
+    std::vector<PlannerTrials> results;
+    
+    for (std::size_t k = 0; k < planners.size(); ++k)
+    {
+        PlannerTrials result;
+        if (!runTrials(plan, planners[k], trials, seed, timeoutMs, result))
+        {
+            return 1;
+        }
+        
+        double median = timeToProbability(result, 0.5);
+        std::cerr << planners[k] << ": " << successProbability(result, timeoutMs) * 100 << "% solved, median time ";
+        if (median < 0)
+        {
+            std::cerr << "not reached" << std::endl;
+        }
+        else
+        {
+            std::cerr << median << " ms" << std::endl;
+        }
+        
+        results.push_back(result);
+    }
+    
+    if (options.has("json"))
+    {
+        std::ofstream file(options.get("json", "").c_str());
+        writeJson(file, rlwrapper::baseName(plan), results, times);
+    }
+    
+    if (options.has("trials-csv"))
+    {
+        std::ofstream file(options.get("trials-csv", "").c_str());
+        writeTrialsCsv(file, results);
+    }
+    
+    if (options.has("curve-csv"))
+    {
+        std::ofstream file(options.get("curve-csv", "").c_str());
+        writeCurveCsv(file, results, times);
+    }
+    
+    if (!options.has("json") && !options.has("trials-csv") && !options.has("curve-csv"))
+    {
+        writeJson(std::cout, rlwrapper::baseName(plan), results, times);
+    }
+    
+    FlushLog();
+    
+    return 0;
+}
@@ -0,0 +1,282 @@
+//
+// rlwrapper_corpus.cpp
+// Macro-benchmark of a corpus of plan XMLs for regression comparison
+//
+// Usage: rlwrapper_corpus --corpus=<directory> [--runs=10] [--planners=rrt,rrtConCon,rrtGoalBias,prm]
+//                         [--threads=1] [--timeout=30000] [--json=<file>] [--csv=<file>]
+// Every <plan>.xml of the directory is loaded with LoadPlanXml; queries are read from <plan>.queries
+// (see readQueries), each query runs --runs times per planner type and thread count.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "RLWrapper.h"
+#include "ToolSupport.h"
+
+// Outcome of one planning call
+struct Run
+{
+    bool success;
+    
+    double latencyMs;
+    
+    double pathLength;
+    
+    long long collisionChecks;
+};
+
+// Aggregated outcome of one plan, planner type and thread count
+struct Result
+{
+    std::string plan;
+    
+    std::string planner;
+    
+    int threads;
+    
+    int queries;
+    
+    std::vector<Run> runs;
+};
+
+// Run all queries of a plan runs times, distributed over threads planner instances
+static bool runConfiguration(const std::string& planPath, const std::string& plannerType, int threads, int runs, int timeoutMs, Result& result)
+{
+    std::vector<void*> planners(threads, nullptr);
+    int dof = 0;
+    
+    for (int i = 0; i < threads; ++i)
+    {
+        planners[i] = CreatePlanner();
+        if (!planners[i] || RL_SUCCESS != LoadPlanXml(planners[i], planPath.c_str()))
+        {
+            std::cerr << "rlwrapper_corpus: Failed to load plan: " << planPath << std::endl;
+            for (int j = 0; j <= i; ++j)
+            {
+                DestroyPlanner(planners[j]);
+            }
+            return false;
+        }
+        dof = GetDof(planners[i]);
+    }
+    
+    std::vector<rlwrapper::PlanQuery> queries = rlwrapper::readQueries(planPath, dof);
+    int total = static_cast<int>(queries.size()) * runs;
+    std::atomic<int> next(0);
+    std::vector<std::vector<Run>> threadRuns(threads);
+    std::vector<std::thread> workers;
+    
+    for (int i = 0; i < threads; ++i)
+    {
+        workers.push_back(std::thread([&, i]()
+        {
+            std::vector<double> waypoints;
+            
+            for (int index = next++; index < total; index = next++)
+            {
+                const rlwrapper::PlanQuery& query = queries[index % queries.size()];
+                
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                int code = rlwrapper::planQuery(planners[i], query, dof, plannerType.c_str(), timeoutMs, waypoints);
+                std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+                
+                RL_PlanStats stats = RL_PlanStats();
+                GetLastPlanStats(planners[i], &stats);
+                
+                Run run;
+                run.success = (RL_SUCCESS == code);
+                run.latencyMs = std::chrono::duration<double, std::milli>(end - start).count();
+                run.pathLength = run.success ? rlwrapper::pathLength(waypoints.data(), static_cast<int>(waypoints.size()) / dof, dof) : 0;
+                run.collisionChecks = stats.collisionChecks;
+                threadRuns[i].push_back(run);
+            }
+        }));
+    }
+    
+    for (std::size_t i = 0; i < workers.size(); ++i)
+    {
+        workers[i].join();
+    }
+    
+    for (int i = 0; i < threads; ++i)
+    {
+        DestroyPlanner(planners[i]);
+        result.runs.insert(result.runs.end(), threadRuns[i].begin(), threadRuns[i].end());
+    }
+    
+    result.plan = rlwrapper::baseName(planPath);
+    result.planner = plannerType;
+    result.threads = threads;
+    result.queries = static_cast<int>(queries.size());
+    
+    return true;
+}
+
+// Summary values of a result, in output column order
+static std::vector<double> summarize(const Result& result)
+{
+    std::vector<double> latencies;
+    double latencySum = 0;
+    double lengthSum = 0;
+    double checksSum = 0;
+    int successes = 0;
+    
+    for (std::size_t i = 0; i < result.runs.size(); ++i)
+    {
+        const Run& run = result.runs[i];
+        latencies.push_back(run.latencyMs);
+        latencySum += run.latencyMs;
+        checksSum += static_cast<double>(run.collisionChecks);
+        if (run.success)
+        {
+            ++successes;
+            lengthSum += run.pathLength;
+        }
+    }
+    
+    double runs = static_cast<double>(std::max<std::size_t>(1, result.runs.size()));
+    
+    std::vector<double> values;
+    values.push_back(static_cast<double>(result.runs.size()));
+    values.push_back(successes);
+    values.push_back(successes / runs);
+    values.push_back(latencySum / runs);
+    values.push_back(rlwrapper::quantile(latencies, 0.5));
+    values.push_back(rlwrapper::quantile(latencies, 0.9));
+    values.push_back(rlwrapper::quantile(latencies, 0.99));
+    values.push_back(latencies.empty() ? 0 : *std::max_element(latencies.begin(), latencies.end()));
+    values.push_back(successes > 0 ? lengthSum / successes : 0);
+    values.push_back(checksSum / runs);
+    
+    return values;
+}
+
+static const char* const summaryColumns[] = {
+    "runs", "successes", "success_rate", "latency_mean_ms", "latency_p50_ms", "latency_p90_ms", "latency_p99_ms",
+    "latency_max_ms", "path_length_mean", "collision_checks_mean"
+};
+
+static void writeJson(std::ostream& out, const std::vector<Result>& results)
+{
+    out << std::setprecision(10) << "{\n  \"results\": [";
+    
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        std::vector<double> values = summarize(results[i]);
+        
+        out << (i > 0 ? "," : "") << "\n    {\"plan\": " << rlwrapper::jsonString(results[i].plan)
+            << ", \"planner\": " << rlwrapper::jsonString(results[i].planner)
+            << ", \"threads\": " << results[i].threads
+            << ", \"queries\": " << results[i].queries;
+        
+        for (std::size_t j = 0; j < values.size(); ++j)
+        {
+            out << ", \"" << summaryColumns[j] << "\": " << values[j];
+        }
+        
+        out << "}";
+    }
+    
+    out << "\n  ]\n}\n";
+}
+
+static void writeCsv(std::ostream& out, const std::vector<Result>& results)
+{
+    out << std::setprecision(10) << "plan,planner,threads,queries";
+    for (std::size_t j = 0; j < sizeof(summaryColumns) / sizeof(summaryColumns[0]); ++j)
+    {
+        out << "," << summaryColumns[j];
+    }
+    out << "\n";
+    
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        std::vector<double> values = summarize(results[i]);
+        
+        out << rlwrapper::csvField(results[i].plan) << "," << rlwrapper::csvField(results[i].planner) << ","
+            << results[i].threads << "," << results[i].queries;
+        for (std::size_t j = 0; j < values.size(); ++j)
+        {
+            out << "," << values[j];
+        }
+        out << "\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    rlwrapper::Options options(argc, argv);
+    
+    if (!options.has("corpus"))
+    {
+        std::cerr << "Usage: rlwrapper_corpus --corpus=<directory> [--runs=10] [--planners=rrt,rrtConCon,rrtGoalBias,prm]" << std::endl
+                  << "                        [--threads=1] [--timeout=30000] [--json=<file>] [--csv=<file>]" << std::endl;
+        return 1;
+    }
+    
+    std::vector<std::string> plans = rlwrapper::listPlanFiles(options.get("corpus", ""));
+    std::vector<std::string> planners = options.getList("planners", "rrt,rrtConCon,rrtGoalBias,prm");
+    std::vector<int> threadCounts = options.getIntList("threads", "1");
+    int runs = std::max(1, options.getInt("runs", 10));
+    int timeoutMs = std::max(1, options.getInt("timeout", 30000));
+    
+    if (plans.empty())
+    {
+        std::cerr << "rlwrapper_corpus: No plan XMLs found in " << options.get("corpus", "") << std::endl;
+        return 1;
+    }
+    
+    SetLogLevel(RL_LOG_LEVEL_WARNING);
+    
+    std::vector<Result> results;
+    
+    for (std::size_t p = 0; p < plans.size(); ++p)
+    {
+        for (std::size_t k = 0; k < planners.size(); ++k)
+        {
+            for (std::size_t t = 0; t < threadCounts.size(); ++t)
+            {
+                Result result;
+                if (!runConfiguration(plans[p], planners[k], std::max(1, threadCounts[t]), runs, timeoutMs, result))
+                {
+                    continue;
+                }
+                
+                std::vector<double> values = summarize(result);
+                std::cerr << result.plan << " " << result.planner << " threads=" << result.threads
+                          << ": success " << values[1] << "/" << values[0] << ", p50 " << values[4] << " ms" << std::endl;
+                
+                results.push_back(result);
+            }
+        }
+    }
+    
+    if (options.has("json"))
+    {
+        std::ofstream file(options.get("json", "").c_str());
+        writeJson(file, results);
+    }
+    
+    if (options.has("csv"))
+    {
+        std::ofstream file(options.get("csv", "").c_str());
+        writeCsv(file, results);
+    }
+    
+    if (!options.has("json") && !options.has("csv"))
+    {
+        writeJson(std::cout, results);
+    }
+    
+    FlushLog();
+    
+    return results.empty() ? 1 : 0;
+}
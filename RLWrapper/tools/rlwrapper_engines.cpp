@@ -0,0 +1,466 @@
+//
+// rlwrapper_engines.cpp
+// Collision engine shootout: the same plan loaded into every compiled-in engine
+//
+// Usage: rlwrapper_engines --plan=<plan.xml> [--engines=fcl,ode,pqp,bullet,solid] [--loads=5] [--checks=1000]
+//                          [--repeats=10] [--trials=10] [--planner=<type>] [--seed=1] [--timeout=30000]
+//                          [--json=<file>] [--csv=<file>]
+// Per engine (SetCollisionEngine before LoadPlanXml) it measures load time, the resident memory added by the
+// first load, single IsValidConfiguration/IsValidSegment latency on a shared set of configurations, and the
+// end-to-end time of seeded planning trials. Planner instances of all engines stay loaded for the whole run
+// so memory deltas do not reuse memory freed by another engine; they remain approximate (allocator caching).
+// The shared configurations are the waypoints of all successful trials, the query start/goal pairs and
+// midpoints of random pairs of these (a mix of free and colliding configurations); results that differ
+// from the first engine are counted as disagreements.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "RLWrapper.h"
+#include "ToolSupport.h"
+
+struct EngineResult
+{
+    EngineResult() : engine(), planner(nullptr), memoryBytes(-1), loadMs(), validityNs(), segmentNs(), valid(0), validSegments(0),
+        validityDisagreements(0), segmentDisagreements(0), planMs(), planSuccesses(0), collisionChecks() {}
+    
+    std::string engine;
+    
+    // Planner instance using the engine, null if the plan could not be loaded with it
+    void* planner;
+    
+    long long memoryBytes;
+    
+    std::vector<double> loadMs;
+    
+    std::vector<double> validityNs;
+    
+    std::vector<double> segmentNs;
+    
+    int valid;
+    
+    int validSegments;
+    
+    int validityDisagreements;
+    
+    int segmentDisagreements;
+    
+    std::vector<double> planMs;
+    
+    int planSuccesses;
+    
+    std::vector<double> collisionChecks;
+};
+
+static double mean(const std::vector<double>& values)
+{
+    double sum = 0;
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        sum += values[i];
+    }
+    
+    return values.empty() ? 0 : sum / values.size();
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double elapsedNs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Seeded planning trials with one engine; appends the waypoints of successful trials to configurations
+static void runTrials(EngineResult& result, const std::vector<rlwrapper::PlanQuery>& queries, int dof, const std::string& plannerType,
+    int trials, unsigned int seed, int timeoutMs, std::vector<double>& configurations)
+{
+    std::vector<double> waypoints;
+    
+    for (int i = 0; i < trials; ++i)
+    {
+        SetRandomSeed(result.planner, seed + static_cast<unsigned int>(i));
+        
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        int code = rlwrapper::planQuery(result.planner, queries[i % queries.size()], dof, plannerType.empty() ? nullptr : plannerType.c_str(), timeoutMs, waypoints);
+        result.planMs.push_back(elapsedMs(start));
+        
+        RL_PlanStats stats = RL_PlanStats();
+        GetLastPlanStats(result.planner, &stats);
+        result.collisionChecks.push_back(static_cast<double>(stats.collisionChecks));
+        
+        if (RL_SUCCESS == code)
+        {
+            ++result.planSuccesses;
+            configurations.insert(configurations.end(), waypoints.begin(), waypoints.end());
+        }
+    }
+}
+
+// count shared configurations drawn from the planned waypoints and query start/goal pairs, every other one a midpoint of two
+static std::vector<double> referenceConfigurations(std::vector<double> configurations, const std::vector<rlwrapper::PlanQuery>& queries,
+    int dof, int count, unsigned int seed)
+{
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        configurations.insert(configurations.end(), queries[i].start.begin(), queries[i].start.end());
+        configurations.insert(configurations.end(), queries[i].goal.begin(), queries[i].goal.end());
+    }
+    
+    std::size_t known = configurations.size() / dof;
+    if (0 == known)
+    {
+        return configurations;
+    }
+    
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<std::size_t> index(0, known - 1);
+    std::vector<double> result;
+    
+    for (int i = 0; i < count; ++i)
+    {
+        std::size_t a = index(generator);
+        std::size_t b = index(generator);
+        
+        for (int j = 0; j < dof; ++j)
+        {
+            double value = configurations[a * dof + j];
+            result.push_back(0 == i % 2 ? value : 0.5 * (value + configurations[b * dof + j]));
+        }
+    }
+    
+    return result;
+}
+
+// Single-check latencies of one engine; results of the first repeat are returned for comparison between engines
+static void runChecks(EngineResult& result, const std::vector<double>& configurations, int dof, int repeats,
+    std::vector<int>& validity, std::vector<int>& segments)
+{
+    int count = static_cast<int>(configurations.size()) / dof;
+    
+    validity.assign(count, 0);
+    segments.assign(count, 0);
+    
+    for (int r = 0; r < repeats; ++r)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            int code = IsValidConfiguration(result.planner, &configurations[i * dof], dof);
+            result.validityNs.push_back(elapsedNs(start));
+            
+            if (0 == r)
+            {
+                validity[i] = code;
+            }
+        }
+        
+        // Segments between consecutive configurations of the set
+        for (int i = 0; i < count; ++i)
+        {
+            int next = (i + 1) % count;
+            
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            int code = IsValidSegment(result.planner, &configurations[i * dof], &configurations[next * dof], dof);
+            result.segmentNs.push_back(elapsedNs(start));
+            
+            if (0 == r)
+            {
+                segments[i] = code;
+            }
+        }
+    }
+    
+    result.valid = static_cast<int>(std::count(validity.begin(), validity.end(), 1));
+    result.validSegments = static_cast<int>(std::count(segments.begin(), segments.end(), 1));
+}
+
+static int countDifferences(const std::vector<int>& a, const std::vector<int>& b)
+{
+    int differences = 0;
+    for (std::size_t i = 0; i < a.size() && i < b.size(); ++i)
+    {
+        differences += (a[i] != b[i]) ? 1 : 0;
+    }
+    
+    return differences;
+}
+
+// Summary values of an engine, in output column order
+static std::vector<double> summarize(const EngineResult& result, int configurations)
+{
+    std::vector<double> values;
+    values.push_back(mean(result.loadMs));
+    values.push_back(rlwrapper::quantile(result.loadMs, 0.5));
+    values.push_back(rlwrapper::quantile(result.loadMs, 0));
+    values.push_back(static_cast<double>(result.memoryBytes));
+    values.push_back(mean(result.validityNs));
+    values.push_back(rlwrapper::quantile(result.validityNs, 0.5));
+    values.push_back(rlwrapper::quantile(result.validityNs, 0.99));
+    values.push_back(configurations > 0 ? static_cast<double>(result.valid) / configurations : 0);
+    values.push_back(result.validityDisagreements);
+    values.push_back(mean(result.segmentNs));
+    values.push_back(rlwrapper::quantile(result.segmentNs, 0.5));
+    values.push_back(rlwrapper::quantile(result.segmentNs, 0.99));
+    values.push_back(configurations > 0 ? static_cast<double>(result.validSegments) / configurations : 0);
+    values.push_back(result.segmentDisagreements);
+    values.push_back(static_cast<double>(result.planMs.size()));
+    values.push_back(result.planSuccesses);
+    values.push_back(mean(result.planMs));
+    values.push_back(rlwrapper::quantile(result.planMs, 0.5));
+    values.push_back(rlwrapper::quantile(result.planMs, 0.9));
+    values.push_back(mean(result.collisionChecks));
+    
+    return values;
+}
+
+static const char* const summaryColumns[] = {
+    "load_mean_ms", "load_p50_ms", "load_min_ms", "memory_bytes",
+    "validity_mean_ns", "validity_p50_ns", "validity_p99_ns", "valid_fraction", "validity_disagreements",
+    "segment_mean_ns", "segment_p50_ns", "segment_p99_ns", "valid_segment_fraction", "segment_disagreements",
+    "plan_trials", "plan_successes", "plan_mean_ms", "plan_p50_ms", "plan_p90_ms", "plan_collision_checks_mean"
+};
+
+static void writeJson(std::ostream& out, const std::string& plan, const std::vector<EngineResult>& results, int configurations)
+{
+    out << std::setprecision(10) << "{\n  \"plan\": " << rlwrapper::jsonString(plan)
+        << ",\n  \"configurations\": " << configurations << ",\n  \"engines\": [";
+    
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        out << (i > 0 ? "," : "") << "\n    {\"engine\": " << rlwrapper::jsonString(results[i].engine)
+            << ", \"loaded\": " << (results[i].planner ? "true" : "false");
+        
+        if (results[i].planner)
+        {
+            std::vector<double> values = summarize(results[i], configurations);
+            for (std::size_t j = 0; j < values.size(); ++j)
+            {
+                out << ", \"" << summaryColumns[j] << "\": ";
+                if (3 == j && results[i].memoryBytes < 0)
+                {
+                    out << "null";
+                }
+                else
+                {
+                    out << values[j];
+                }
+            }
+        }
+        
+        out << "}";
+    }
+    
+    out << "\n  ]\n}\n";
+}
+
+static void writeCsv(std::ostream& out, const std::string& plan, const std::vector<EngineResult>& results, int configurations)
+{
+    out << std::setprecision(10) << "plan,engine,configurations";
+    for (std::size_t j = 0; j < sizeof(summaryColumns) / sizeof(summaryColumns[0]); ++j)
+    {
+        out << "," << summaryColumns[j];
+    }
+    out << "\n";
+    
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        if (!results[i].planner)
+        {
+            continue;
+        }
+        
+        std::vector<double> values = summarize(results[i], configurations);
+        
+        out << rlwrapper::csvField(plan) << "," << rlwrapper::csvField(results[i].engine) << "," << configurations;
+        for (std::size_t j = 0; j < values.size(); ++j)
+        {
+            out << "," << values[j];
+        }
+        out << "\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    rlwrapper::Options options(argc, argv);
+    
+    if (!options.has("plan"))
+    {
+        std::cerr << "Usage: rlwrapper_engines --plan=<plan.xml> [--engines=fcl,ode,pqp,bullet,solid] [--loads=5] [--checks=1000]" << std::endl
+                  << "                         [--repeats=10] [--trials=10] [--planner=<type>] [--seed=1] [--timeout=30000]" << std::endl
+                  << "                         [--json=<file>] [--csv=<file>]" << std::endl;
+        return 1;
+    }
+    
+    char compiled[256];
+    int compiledLength = 0;
+    if (RL_SUCCESS != GetCollisionEngines(compiled, sizeof(compiled), &compiledLength) || 0 == compiledLength)
+    {
+        std::cerr << "rlwrapper_engines: No collision engines compiled in" << std::endl;
+        return 1;
+    }
+    
+    std::string plan = options.get("plan", "");
+    std::vector<std::string> engines = options.getList("engines", compiled);
+    int loads = std::max(1, options.getInt("loads", 5));
+    int checks = std::max(1, options.getInt("checks", 1000));
+    int repeats = std::max(1, options.getInt("repeats", 10));
+    int trials = std::max(0, options.getInt("trials", 10));
+    std::string plannerType = options.get("planner", "");
+    unsigned int seed = static_cast<unsigned int>(options.getInt("seed", 1));
+    int timeoutMs = std::max(1, options.getInt("timeout", 30000));
+    
+    SetLogLevel(RL_LOG_LEVEL_WARNING);
+    
+    // Warm-up load with the default engine, kept alive so one-time initialization is not attributed to an engine
+    void* warmup = CreatePlanner();
+    if (!warmup || RL_SUCCESS != LoadPlanXml(warmup, plan.c_str()))
+    {
+        std::cerr << "rlwrapper_engines: Failed to load plan: " << plan << std::endl;
+        DestroyPlanner(warmup);
+        return 1;
+    }
+    int dof = GetDof(warmup);
+    
+    std::vector<EngineResult> results(engines.size());
+    
+    // First load of every engine, measuring the resident memory it adds
+    for (std::size_t k = 0; k < engines.size(); ++k)
+    {
+        EngineResult& result = results[k];
+        result.engine = engines[k];
+        result.planner = CreatePlanner();
+        
+        if (RL_SUCCESS != SetCollisionEngine(result.planner, engines[k].c_str()))
+        {
+            std::cerr << "rlwrapper_engines: Engine not compiled in: " << engines[k] << std::endl;
+            DestroyPlanner(result.planner);
+            result.planner = nullptr;
+            continue;
+        }
+        
+        long long before = rlwrapper::residentMemoryBytes();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        int code = LoadPlanXml(result.planner, plan.c_str());
+        double loadMs = elapsedMs(start);
+        long long after = rlwrapper::residentMemoryBytes();
+        
+        if (RL_SUCCESS != code || GetDof(result.planner) != dof)
+        {
+            std::cerr << "rlwrapper_engines: Failed to load plan with " << engines[k] << std::endl;
+            DestroyPlanner(result.planner);
+            result.planner = nullptr;
+            continue;
+        }
+        
+        result.loadMs.push_back(loadMs);
+        result.memoryBytes = (before < 0 || after < 0) ? -1 : after - before;
+    }
+    
+    // Further loads, interleaved between engines so drift affects all of them alike
+    for (int i = 1; i < loads; ++i)
+    {
+        for (std::size_t k = 0; k < results.size(); ++k)
+        {
+            if (results[k].planner)
+            {
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                LoadPlanXml(results[k].planner, plan.c_str());
+                results[k].loadMs.push_back(elapsedMs(start));
+            }
+        }
+    }
+    
+    // End-to-end planning
+    std::vector<rlwrapper::PlanQuery> queries = rlwrapper::readQueries(plan, dof);
+    std::vector<double> planned;
+    
+    for (std::size_t k = 0; k < results.size(); ++k)
+    {
+        if (results[k].planner)
+        {
+            runTrials(results[k], queries, dof, plannerType, trials, seed, timeoutMs, planned);
+        }
+    }
+    
+    // Single checks on the shared configurations
+    std::vector<double> configurations = referenceConfigurations(planned, queries, dof, checks, seed);
+    int configurationCount = static_cast<int>(configurations.size()) / dof;
+    std::vector<int> referenceValidity;
+    std::vector<int> referenceSegments;
+    
+    if (0 == configurationCount)
+    {
+        std::cerr << "rlwrapper_engines: No configurations for single checks (no successful trial and no query file)" << std::endl;
+    }
+    
+    for (std::size_t k = 0; k < results.size() && configurationCount > 0; ++k)
+    {
+        if (!results[k].planner)
+        {
+            continue;
+        }
+        
+        std::vector<int> validity;
+        std::vector<int> segments;
+        runChecks(results[k], configurations, dof, repeats, validity, segments);
+        
+        if (referenceValidity.empty())
+        {
+            referenceValidity = validity;
+            referenceSegments = segments;
+        }
+        
+        results[k].validityDisagreements = countDifferences(referenceValidity, validity);
+        results[k].segmentDisagreements = countDifferences(referenceSegments, segments);
+    }
+    
+    for (std::size_t k = 0; k < results.size(); ++k)
+    {
+        if (results[k].planner)
+        {
+            std::cerr << results[k].engine << ": load " << rlwrapper::quantile(results[k].loadMs, 0.5) << " ms, check "
+                      << rlwrapper::quantile(results[k].validityNs, 0.5) << " ns, plan " << rlwrapper::quantile(results[k].planMs, 0.5)
+                      << " ms (" << results[k].planSuccesses << "/" << results[k].planMs.size() << " solved)" << std::endl;
+        }
+    }
+    
+    if (options.has("json"))
+    {
+        std::ofstream file(options.get("json", "").c_str());
+        writeJson(file, rlwrapper::baseName(plan), results, configurationCount);
+    }
+    
+    if (options.has("csv"))
+    {
+        std::ofstream file(options.get("csv", "").c_str());
+        writeCsv(file, rlwrapper::baseName(plan), results, configurationCount);
+    }
+    
+    if (!options.has("json") && !options.has("csv"))
+    {
+        writeJson(std::cout, rlwrapper::baseName(plan), results, configurationCount);
+    }
+    
+    bool loaded = false;
+    for (std::size_t k = 0; k < results.size(); ++k)
+    {
+        loaded = loaded || results[k].planner;
+        DestroyPlanner(results[k].planner);
+    }
+    DestroyPlanner(warmup);
+    
+    FlushLog();
+    
+    return loaded ? 0 : 1;
+}
@@ -0,0 +1,489 @@
+//
+// rlwrapper_loadtest.cpp
+// Concurrency load test: many client threads driving many planner handles with a mix of operations
+//
+// Usage: rlwrapper_loadtest --plans=<plan.xml>[,<plan.xml>...] [--clients=64] [--handles=<clients>]
+//                           [--mix=plan:1,validity:20,segment:5,fk:5,load:0] [--duration=10] [--timeout=5000]
+//                           [--baseline=20] [--seed=1] [--json=<file>] [--csv=<file>] [--metrics=<file>] [--trace=<file>]
+// Handle h loads plan h % plans; client c uses handle c % handles, guarded by a per-handle mutex since planner
+// instances are not thread-safe. Each operation records the time spent waiting for its handle and the time of
+// the call itself. Before the load phase every operation type runs --baseline times on one uncontended handle;
+// the ratio of loaded to uncontended median latency points at contention inside the library, handle wait
+// time at contention between clients sharing a handle. For a closer look at the hot spots --metrics writes
+// DumpMetrics at the end of the run and --trace the ExportTrace events recorded during the load phase.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "RLWrapper.h"
+#include "ToolSupport.h"
+
+enum Operation
+{
+    OPERATION_PLAN,
+    OPERATION_VALIDITY,
+    OPERATION_SEGMENT,
+    OPERATION_FK,
+    OPERATION_LOAD,
+    OPERATION_COUNT
+};
+
+static const char* const operationNames[OPERATION_COUNT] = { "plan", "validity", "segment", "fk", "load" };
+
+// Planner instance shared by the clients c with c % handles == index
+struct Handle
+{
+    Handle() : planner(nullptr), plan(), dof(0), queries(), configurations(), mutex() {}
+    
+    void* planner;
+    
+    std::string plan;
+    
+    int dof;
+    
+    std::vector<rlwrapper::PlanQuery> queries;
+    
+    // Configurations for validity, segment and forward kinematics operations (flattened, dof values each)
+    std::vector<double> configurations;
+    
+    std::mutex mutex;
+};
+
+// Samples of one client or of the uncontended baseline
+struct ClientStats
+{
+    ClientStats() : latencyMs(), waitMs(), failures() {}
+    
+    std::vector<double> latencyMs[OPERATION_COUNT];
+    
+    std::vector<double> waitMs[OPERATION_COUNT];
+    
+    long long failures[OPERATION_COUNT];
+};
+
+static double elapsedMs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+static double sum(const std::vector<double>& values)
+{
+    double total = 0;
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        total += values[i];
+    }
+    
+    return total;
+}
+
+// Weights of --mix, e.g. "plan:1,validity:20"; returns false for unknown operations
+static bool parseMix(const std::vector<std::string>& items, double weights[OPERATION_COUNT])
+{
+    std::fill(weights, weights + OPERATION_COUNT, 0.0);
+    
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        std::size_t colon = items[i].find(':');
+        std::string name = items[i].substr(0, colon);
+        double weight = (std::string::npos == colon) ? 1.0 : std::atof(items[i].substr(colon + 1).c_str());
+        
+        int operation = 0;
+        while (operation < OPERATION_COUNT && name != operationNames[operation])
+        {
+            ++operation;
+        }
+        if (OPERATION_COUNT == operation)
+        {
+            std::cerr << "rlwrapper_loadtest: Unknown operation in --mix: " << name << std::endl;
+            return false;
+        }
+        
+        weights[operation] = std::max(0.0, weight);
+    }
+    
+    return true;
+}
+
+// Load the plan of a handle and plan its queries once for a set of valid configurations
+static bool setupHandle(Handle& handle, int timeoutMs, unsigned int seed)
+{
+    handle.planner = CreatePlanner();
+    if (!handle.planner || RL_SUCCESS != LoadPlanXml(handle.planner, handle.plan.c_str()))
+    {
+        std::cerr << "rlwrapper_loadtest: Failed to load plan: " << handle.plan << std::endl;
+        return false;
+    }
+    
+    handle.dof = GetDof(handle.planner);
+    handle.queries = rlwrapper::readQueries(handle.plan, handle.dof);
+    
+    std::vector<double> waypoints;
+    for (std::size_t i = 0; i < handle.queries.size(); ++i)
+    {
+        const rlwrapper::PlanQuery& query = handle.queries[i];
+        handle.configurations.insert(handle.configurations.end(), query.start.begin(), query.start.end());
+        handle.configurations.insert(handle.configurations.end(), query.goal.begin(), query.goal.end());
+        
+        SetRandomSeed(handle.planner, seed);
+        if (RL_SUCCESS == rlwrapper::planQuery(handle.planner, query, handle.dof, nullptr, timeoutMs, waypoints))
+        {
+            handle.configurations.insert(handle.configurations.end(), waypoints.begin(), waypoints.end());
+        }
+    }
+    
+    return true;
+}
+
+// Run one operation on a handle, returning false if it did not succeed
+static bool runOperation(Handle& handle, int operation, std::mt19937& generator, int timeoutMs, std::vector<double>& waypoints)
+{
+    int dof = handle.dof;
+    int count = static_cast<int>(handle.configurations.size()) / std::max(1, dof);
+    const double* from = count > 0 ? &handle.configurations[(generator() % count) * dof] : nullptr;
+    const double* to = count > 0 ? &handle.configurations[(generator() % count) * dof] : nullptr;
+    
+    switch (operation)
+    {
+    case OPERATION_PLAN:
+        return RL_SUCCESS == rlwrapper::planQuery(handle.planner, handle.queries[generator() % handle.queries.size()], dof, nullptr, timeoutMs, waypoints);
+    case OPERATION_VALIDITY:
+        return IsValidConfiguration(handle.planner, from, dof) >= 0;
+    case OPERATION_SEGMENT:
+        return IsValidSegment(handle.planner, from, to, dof) >= 0;
+    case OPERATION_FK:
+        {
+            double pose[7];
+            return RL_SUCCESS == ForwardKinematics(handle.planner, from, dof, pose, 7);
+        }
+    case OPERATION_LOAD:
+        return RL_SUCCESS == LoadPlanXml(handle.planner, handle.plan.c_str());
+    default:
+        return false;
+    }
+}
+
+// Run an operation with the handle lock held, recording wait and call time
+static void timedOperation(Handle& handle, int operation, std::mt19937& generator, int timeoutMs, std::vector<double>& waypoints, ClientStats& stats)
+{
+    std::chrono::steady_clock::time_point request = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(handle.mutex);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    
+    bool success = runOperation(handle, operation, generator, timeoutMs, waypoints);
+    
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    stats.waitMs[operation].push_back(elapsedMs(request, start));
+    stats.latencyMs[operation].push_back(elapsedMs(start, end));
+    stats.failures[operation] += success ? 0 : 1;
+}
+
+static void writeJson(std::ostream& out, const std::vector<std::unique_ptr<Handle>>& handles, int clients, double durationMs,
+    const ClientStats& baseline, const ClientStats& total, const std::vector<double>& handleWaitMs, const std::vector<double>& handleBusyMs)
+{
+    long long operations = 0;
+    for (int k = 0; k < OPERATION_COUNT; ++k)
+    {
+        operations += static_cast<long long>(total.latencyMs[k].size());
+    }
+    
+    out << std::setprecision(10) << "{\n  \"clients\": " << clients
+        << ",\n  \"handles\": " << handles.size()
+        << ",\n  \"duration_s\": " << durationMs / 1000
+        << ",\n  \"operations\": " << operations
+        << ",\n  \"throughput_per_s\": " << (durationMs > 0 ? operations * 1000 / durationMs : 0)
+        << ",\n  \"operation_stats\": [";
+    
+    bool first = true;
+    for (int k = 0; k < OPERATION_COUNT; ++k)
+    {
+        const std::vector<double>& latency = total.latencyMs[k];
+        if (latency.empty())
+        {
+            continue;
+        }
+        
+        double baselineP50 = rlwrapper::quantile(baseline.latencyMs[k], 0.5);
+        double p50 = rlwrapper::quantile(latency, 0.5);
+        
+        out << (first ? "" : ",") << "\n    {\"operation\": \"" << operationNames[k] << "\""
+            << ", \"count\": " << latency.size()
+            << ", \"failures\": " << total.failures[k]
+            << ", \"throughput_per_s\": " << (durationMs > 0 ? latency.size() * 1000 / durationMs : 0)
+            << ", \"latency_mean_ms\": " << sum(latency) / latency.size()
+            << ", \"latency_p50_ms\": " << p50
+            << ", \"latency_p90_ms\": " << rlwrapper::quantile(latency, 0.9)
+            << ", \"latency_p99_ms\": " << rlwrapper::quantile(latency, 0.99)
+            << ", \"latency_p999_ms\": " << rlwrapper::quantile(latency, 0.999)
+            << ", \"latency_max_ms\": " << rlwrapper::quantile(latency, 1)
+            << ", \"wait_p50_ms\": " << rlwrapper::quantile(total.waitMs[k], 0.5)
+            << ", \"wait_p99_ms\": " << rlwrapper::quantile(total.waitMs[k], 0.99)
+            << ", \"baseline_p50_ms\": ";
+        if (baseline.latencyMs[k].empty())
+        {
+            out << "null, \"slowdown_p50\": null}";
+        }
+        else
+        {
+            out << baselineP50 << ", \"slowdown_p50\": " << (baselineP50 > 0 ? p50 / baselineP50 : 0) << "}";
+        }
+        first = false;
+    }
+    
+    out << "\n  ],\n  \"handle_stats\": [";
+    
+    for (std::size_t h = 0; h < handles.size(); ++h)
+    {
+        out << (h > 0 ? "," : "") << "\n    {\"handle\": " << h
+            << ", \"plan\": " << rlwrapper::jsonString(rlwrapper::baseName(handles[h]->plan))
+            << ", \"clients\": " << (clients / handles.size() + (h < clients % handles.size() ? 1 : 0))
+            << ", \"utilization\": " << (durationMs > 0 ? handleBusyMs[h] / durationMs : 0)
+            << ", \"wait_total_ms\": " << handleWaitMs[h] << "}";
+    }
+    
+    out << "\n  ]\n}\n";
+}
+
+static void writeCsv(std::ostream& out, int clients, std::size_t handles, double durationMs, const ClientStats& baseline, const ClientStats& total)
+{
+    out << std::setprecision(10) << "clients,handles,operation,count,failures,throughput_per_s,latency_mean_ms,latency_p50_ms,"
+        << "latency_p90_ms,latency_p99_ms,latency_p999_ms,latency_max_ms,wait_p50_ms,wait_p99_ms,baseline_p50_ms\n";
+    
+    for (int k = 0; k < OPERATION_COUNT; ++k)
+    {
+        const std::vector<double>& latency = total.latencyMs[k];
+        if (latency.empty())
+        {
+            continue;
+        }
+        
+        out << clients << "," << handles << "," << operationNames[k] << "," << latency.size() << "," << total.failures[k]
+            << "," << (durationMs > 0 ? latency.size() * 1000 / durationMs : 0)
+            << "," << sum(latency) / latency.size()
+            << "," << rlwrapper::quantile(latency, 0.5)
+            << "," << rlwrapper::quantile(latency, 0.9)
+            << "," << rlwrapper::quantile(latency, 0.99)
+            << "," << rlwrapper::quantile(latency, 0.999)
+            << "," << rlwrapper::quantile(latency, 1)
+            << "," << rlwrapper::quantile(total.waitMs[k], 0.5)
+            << "," << rlwrapper::quantile(total.waitMs[k], 0.99)
+            << "," << rlwrapper::quantile(baseline.latencyMs[k], 0.5) << "\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    rlwrapper::Options options(argc, argv);
+    
+    if (!options.has("plans"))
+    {
+        std::cerr << "Usage: rlwrapper_loadtest --plans=<plan.xml>[,<plan.xml>...] [--clients=64] [--handles=<clients>]" << std::endl
+                  << "                          [--mix=plan:1,validity:20,segment:5,fk:5,load:0] [--duration=10] [--timeout=5000]" << std::endl
+                  << "                          [--baseline=20] [--seed=1] [--json=<file>] [--csv=<file>] [--metrics=<file>] [--trace=<file>]" << std::endl;
+        return 1;
+    }
+    
+    std::vector<std::string> plans = options.getList("plans", "");
+    int clients = std::max(1, options.getInt("clients", 64));
+    int handleCount = std::max(1, std::min(clients, options.getInt("handles", clients)));
+    double durationMs = std::max(0.001, options.getDouble("duration", 10)) * 1000;
+    int timeoutMs = std::max(1, options.getInt("timeout", 5000));
+    int baselineCount = std::max(0, options.getInt("baseline", 20));
+    unsigned int seed = static_cast<unsigned int>(options.getInt("seed", 1));
+    
+    double weights[OPERATION_COUNT];
+    if (plans.empty() || !parseMix(options.getList("mix", "plan:1,validity:20,segment:5,fk:5,load:0"), weights))
+    {
+        return 1;
+    }
+    
+    SetLogLevel(RL_LOG_LEVEL_WARNING);
+    
+    std::vector<std::unique_ptr<Handle>> handles;
+    bool configurations = true;
+    
+    for (int h = 0; h < handleCount; ++h)
+    {
+        handles.push_back(std::unique_ptr<Handle>(new Handle()));
+        handles[h]->plan = plans[h % plans.size()];
+        
+        if (!setupHandle(*handles[h], timeoutMs, seed))
+        {
+            for (int i = 0; i <= h; ++i)
+            {
+                DestroyPlanner(handles[i]->planner);
+            }
+            return 1;
+        }
+        
+        configurations = configurations && !handles[h]->configurations.empty();
+    }
+    
+    // Operations on configurations need a successful setup plan or a query file for every handle
+    if (!configurations)
+    {
+        std::cerr << "rlwrapper_loadtest: No configurations for some plans, dropping validity, segment and fk operations" << std::endl;
+        weights[OPERATION_VALIDITY] = weights[OPERATION_SEGMENT] = weights[OPERATION_FK] = 0;
+    }
+    
+    if (std::count(weights, weights + OPERATION_COUNT, 0.0) == OPERATION_COUNT)
+    {
+        std::cerr << "rlwrapper_loadtest: No operations in --mix" << std::endl;
+        for (std::size_t h = 0; h < handles.size(); ++h)
+        {
+            DestroyPlanner(handles[h]->planner);
+        }
+        return 1;
+    }
+    
+    std::discrete_distribution<int> mix(weights, weights + OPERATION_COUNT);
+    
+    // Uncontended latency of every operation type on the first handle
+    ClientStats baseline;
+    std::mt19937 baselineGenerator(seed);
+    std::vector<double> waypoints;
+    
+    for (int k = 0; k < OPERATION_COUNT; ++k)
+    {
+        for (int i = 0; i < baselineCount && weights[k] > 0; ++i)
+        {
+            timedOperation(*handles[0], k, baselineGenerator, timeoutMs, waypoints, baseline);
+        }
+    }
+    
+    // Load phase
+    EnableTracing(options.has("trace") ? 1 : 0);
+    
+    std::vector<ClientStats> clientStats(clients);
+    std::atomic<bool> stop(false);
+    std::atomic<int> ready(0);
+    std::vector<std::thread> workers;
+    
+    for (int c = 0; c < clients; ++c)
+    {
+        workers.push_back(std::thread([&, c]()
+        {
+            Handle& handle = *handles[c % handleCount];
+            std::mt19937 generator(seed + 1 + static_cast<unsigned int>(c));
+            std::discrete_distribution<int> operations(mix);
+            std::vector<double> clientWaypoints;
+            
+            // Start all clients together
+            ++ready;
+            while (ready < clients)
+            {
+                std::this_thread::yield();
+            }
+            
+            while (!stop)
+            {
+                timedOperation(handle, operations(generator), generator, timeoutMs, clientWaypoints, clientStats[c]);
+            }
+        }));
+    }
+    
+    while (ready < clients)
+    {
+        std::this_thread::yield();
+    }
+    
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(durationMs));
+    stop = true;
+    
+    for (std::size_t i = 0; i < workers.size(); ++i)
+    {
+        workers[i].join();
+    }
+    
+    // Includes operations still running at the end of the duration
+    double elapsed = elapsedMs(start, std::chrono::steady_clock::now());
+    
+    EnableTracing(0);
+    
+    ClientStats total;
+    std::vector<double> handleWaitMs(handleCount, 0.0);
+    std::vector<double> handleBusyMs(handleCount, 0.0);
+    
+    for (int c = 0; c < clients; ++c)
+    {
+        for (int k = 0; k < OPERATION_COUNT; ++k)
+        {
+            total.latencyMs[k].insert(total.latencyMs[k].end(), clientStats[c].latencyMs[k].begin(), clientStats[c].latencyMs[k].end());
+            total.waitMs[k].insert(total.waitMs[k].end(), clientStats[c].waitMs[k].begin(), clientStats[c].waitMs[k].end());
+            total.failures[k] += clientStats[c].failures[k];
+            
+            handleWaitMs[c % handleCount] += sum(clientStats[c].waitMs[k]);
+            handleBusyMs[c % handleCount] += sum(clientStats[c].latencyMs[k]);
+        }
+    }
+    
+    for (int k = 0; k < OPERATION_COUNT; ++k)
+    {
+        if (!total.latencyMs[k].empty())
+        {
+            std::cerr << operationNames[k] << ": " << total.latencyMs[k].size() << " ops, p50 " << rlwrapper::quantile(total.latencyMs[k], 0.5)
+                      << " ms, p99 " << rlwrapper::quantile(total.latencyMs[k], 0.99) << " ms, wait p99 "
+                      << rlwrapper::quantile(total.waitMs[k], 0.99) << " ms";
+            
+            double baselineP50 = rlwrapper::quantile(baseline.latencyMs[k], 0.5);
+            if (baselineP50 > 0)
+            {
+                std::cerr << ", p50 " << rlwrapper::quantile(total.latencyMs[k], 0.5) / baselineP50 << "x uncontended";
+            }
+            std::cerr << std::endl;
+        }
+    }
+    
+    std::size_t busiest = std::max_element(handleWaitMs.begin(), handleWaitMs.end()) - handleWaitMs.begin();
+    std::cerr << "most contended handle: " << busiest << " (" << rlwrapper::baseName(handles[busiest]->plan) << "), "
+              << handleWaitMs[busiest] << " ms total wait" << std::endl;
+    
+    if (options.has("json"))
+    {
+        std::ofstream file(options.get("json", "").c_str());
+        writeJson(file, handles, clients, elapsed, baseline, total, handleWaitMs, handleBusyMs);
+    }
+    
+    if (options.has("csv"))
+    {
+        std::ofstream file(options.get("csv", "").c_str());
+        writeCsv(file, clients, handles.size(), elapsed, baseline, total);
+    }
+    
+    if (!options.has("json") && !options.has("csv"))
+    {
+        writeJson(std::cout, handles, clients, elapsed, baseline, total, handleWaitMs, handleBusyMs);
+    }
+    
+    if (options.has("metrics") && RL_SUCCESS != DumpMetrics(options.get("metrics", "").c_str()))
+    {
+        std::cerr << "rlwrapper_loadtest: Failed to write metrics: " << options.get("metrics", "") << std::endl;
+    }
+    
+    if (options.has("trace") && RL_SUCCESS != ExportTrace(options.get("trace", "").c_str()))
+    {
+        std::cerr << "rlwrapper_loadtest: Failed to write trace: " << options.get("trace", "") << std::endl;
+    }
+    
+    for (std::size_t h = 0; h < handles.size(); ++h)
+    {
+        DestroyPlanner(handles[h]->planner);
+    }
+    
+    FlushLog();
+    
+    return 0;
+}
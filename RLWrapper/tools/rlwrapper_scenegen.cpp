@@ -0,0 +1,522 @@
+//
+// rlwrapper_scenegen.cpp
+// Generator of synthetic planning workloads for scaling benchmarks
+//
+// Usage: rlwrapper_scenegen --output=<directory> [--dof=2,4,6,8,10,12] [--obstacles=0,10,50] [--passage=0]
+//                           [--reach=1.0] [--obstacle-size=0.05,0.2] [--seed=1] [--planner=rrtConCon]
+//                           [--duration=30] [--queries=0]
+//
+// For each combination of DOF, obstacle count and passage width, writes a planar serial chain
+// (all joints about z, links along x) with random box clutter:
+//   <output>/<name>.xml                 plan XML for LoadPlanXml / rlwrapper_corpus
+//   <output>/<name>.queries             collision-free start/goal pairs (with --queries > 0)
+//   <output>/models/<name>.rlmdl.xml    kinematics and dynamics
+//   <output>/models/<name>.rlsg.xml     scene, model 0 robot, model 1 obstacles
+//   <output>/models/<name>.wrl          scene geometry
+// Start is the chain stretched along +x, goal stretched along -x. A passage width > 0 adds two
+// walls on the y axis leaving only a slit of that width around the x axis, so the chain has to
+// fold flat to pass. Clutter never overlaps the start and goal poses.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include "RLWrapper.h"
+#include "ToolSupport.h"
+
+// Axis-aligned box obstacle
+struct Box
+{
+    double center[3];
+    
+    double size[3];
+};
+
+// Parameters of one generated workload
+struct Workload
+{
+    std::string name;
+    
+    int dof;
+    
+    int obstacles;
+    
+    double passage;
+    
+    double reach;
+    
+    double minSize;
+    
+    double maxSize;
+    
+    unsigned int seed;
+    
+    std::string planner;
+    
+    double duration;
+};
+
+static const double linkWidth = 0.04;
+
+static const double sceneHeight = 0.2;
+
+static bool makeDirectory(const std::string& path)
+{
+#ifdef _WIN32
+    _mkdir(path.c_str());
+#else
+    mkdir(path.c_str(), 0755);
+#endif
+    std::ofstream probe((path + "/.probe").c_str());
+    bool writable = static_cast<bool>(probe);
+    probe.close();
+    std::remove((path + "/.probe").c_str());
+    return writable;
+}
+
+// Helper function to check if a box keeps clear of the start and goal poses (chain along the x axis, including the base)
+static bool isClearOfStartAndGoal(const Box& box, double reach)
+{
+    double margin = linkWidth;
+    double yMin = box.center[1] - 0.5 * box.size[1];
+    double yMax = box.center[1] + 0.5 * box.size[1];
+    double xMin = box.center[0] - 0.5 * box.size[0];
+    double xMax = box.center[0] + 0.5 * box.size[0];
+    
+    bool overlapsStrip = yMin < 0.5 * linkWidth + margin && yMax > -0.5 * linkWidth - margin &&
+        xMin < reach + margin && xMax > -reach - margin;
+    
+    return !overlapsStrip;
+}
+
+static std::vector<Box> generateObstacles(const Workload& workload)
+{
+    std::vector<Box> boxes;
+    std::mt19937 engine(workload.seed);
+    std::uniform_real_distribution<double> position(-workload.reach, workload.reach);
+    std::uniform_real_distribution<double> size(workload.minSize, workload.maxSize);
+    
+    // Walls of the narrow passage, from the slit out beyond the reach of the chain
+    if (workload.passage > 0)
+    {
+        double length = workload.reach + 0.2 - 0.5 * workload.passage;
+        for (int side = -1; side <= 1; side += 2)
+        {
+            Box wall;
+            wall.center[0] = 0;
+            wall.center[1] = side * (0.5 * workload.passage + 0.5 * length);
+            wall.center[2] = 0;
+            wall.size[0] = 0.05;
+            wall.size[1] = length;
+            wall.size[2] = sceneHeight;
+            boxes.push_back(wall);
+        }
+    }
+    
+    int attempts = 0;
+    int placed = 0;
+    while (placed < workload.obstacles && attempts < 1000 * std::max(1, workload.obstacles))
+    {
+        ++attempts;
+        
+        Box box;
+        box.center[0] = position(engine);
+        box.center[1] = position(engine);
+        box.center[2] = 0;
+        box.size[0] = size(engine);
+        box.size[1] = size(engine);
+        box.size[2] = sceneHeight;
+        
+        if (isClearOfStartAndGoal(box, workload.reach))
+        {
+            boxes.push_back(box);
+            ++placed;
+        }
+    }
+    
+    if (placed < workload.obstacles)
+    {
+        std::cerr << workload.name << ": Placed only " << placed << " of " << workload.obstacles << " obstacles" << std::endl;
+    }
+    
+    return boxes;
+}
+
+static void writeVector(std::ostream& out, const char* element, double x, double y, double z, const std::string& indent)
+{
+    out << indent << "<" << element << ">\n"
+        << indent << "\t<x>" << x << "</x>\n"
+        << indent << "\t<y>" << y << "</y>\n"
+        << indent << "\t<z>" << z << "</z>\n"
+        << indent << "</" << element << ">\n";
+}
+
+// Serial chain: world - base (body0) - joint0 - body1 - fixed link - frame1 - joint1 - body2 ... - tool frame
+static void writeKinematics(const Workload& workload, const std::string& path)
+{
+    std::ofstream out(path.c_str());
+    out.precision(10);
+    double length = workload.reach / workload.dof;
+    double mass = 1.0;
+    
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<rlmdl>\n"
+        << "\t<model>\n"
+        << "\t\t<manufacturer>rlwrapper_scenegen</manufacturer>\n"
+        << "\t\t<name>" << workload.name << "</name>\n"
+        << "\t\t<world id=\"world\">\n";
+    writeVector(out, "rotation", 0, 0, 0, "\t\t\t");
+    writeVector(out, "translation", 0, 0, 0, "\t\t\t");
+    writeVector(out, "g", 0, 0, 9.86960440108935, "\t\t\t");
+    out << "\t\t</world>\n";
+    
+    for (int i = 0; i <= workload.dof; ++i)
+    {
+        out << "\t\t<body id=\"body" << i << "\">\n";
+        if (i > 0)
+        {
+            out << "\t\t\t<ignore idref=\"body" << (i - 1) << "\"/>\n";
+        }
+        if (i < workload.dof)
+        {
+            out << "\t\t\t<ignore idref=\"body" << (i + 1) << "\"/>\n";
+        }
+        writeVector(out, "cm", i > 0 ? 0.5 * length : 0, 0, 0, "\t\t\t");
+        double inertia = i > 0 ? mass * length * length / 12.0 : 0.001;
+        out << "\t\t\t<i>\n"
+            << "\t\t\t\t<xx>0.001</xx>\n"
+            << "\t\t\t\t<yy>" << inertia << "</yy>\n"
+            << "\t\t\t\t<zz>" << inertia << "</zz>\n"
+            << "\t\t\t\t<xy>0</xy>\n"
+            << "\t\t\t\t<xz>0</xz>\n"
+            << "\t\t\t\t<yz>0</yz>\n"
+            << "\t\t\t</i>\n"
+            << "\t\t\t<m>" << (i > 0 ? mass : 10.0) << "</m>\n"
+            << "\t\t</body>\n";
+    }
+    
+    out << "\t\t<fixed id=\"fixed0\">\n"
+        << "\t\t\t<frame>\n"
+        << "\t\t\t\t<a idref=\"world\"/>\n"
+        << "\t\t\t\t<b idref=\"body0\"/>\n"
+        << "\t\t\t</frame>\n";
+    writeVector(out, "rotation", 0, 0, 0, "\t\t\t");
+    writeVector(out, "translation", 0, 0, 0, "\t\t\t");
+    out << "\t\t</fixed>\n";
+    
+    for (int i = 0; i < workload.dof; ++i)
+    {
+        std::string parent = (0 == i) ? "body0" : "frame" + std::to_string(i);
+        
+        if (i > 0)
+        {
+            out << "\t\t<frame id=\"frame" << i << "\"/>\n"
+                << "\t\t<fixed id=\"fixed" << i << "\">\n"
+                << "\t\t\t<frame>\n"
+                << "\t\t\t\t<a idref=\"body" << i << "\"/>\n"
+                << "\t\t\t\t<b idref=\"frame" << i << "\"/>\n"
+                << "\t\t\t</frame>\n";
+            writeVector(out, "rotation", 0, 0, 0, "\t\t\t");
+            writeVector(out, "translation", length, 0, 0, "\t\t\t");
+            out << "\t\t</fixed>\n";
+        }
+        
+        out << "\t\t<revolute id=\"joint" << i << "\">\n"
+            << "\t\t\t<frame>\n"
+            << "\t\t\t\t<a idref=\"" << parent << "\"/>\n"
+            << "\t\t\t\t<b idref=\"body" << (i + 1) << "\"/>\n"
+            << "\t\t\t</frame>\n";
+        writeVector(out, "axis", 0, 0, 1, "\t\t\t");
+        out << "\t\t\t<max unit=\"deg\">" << (0 == i ? 180 : 150) << "</max>\n"
+            << "\t\t\t<min unit=\"deg\">" << (0 == i ? -180 : -150) << "</min>\n"
+            << "\t\t\t<speed unit=\"deg\">90</speed>\n"
+            << "\t\t</revolute>\n";
+    }
+    
+    // Tool frame at the end of the last link
+    out << "\t\t<frame id=\"tool\"/>\n"
+        << "\t\t<fixed id=\"fixed" << workload.dof << "\">\n"
+        << "\t\t\t<frame>\n"
+        << "\t\t\t\t<a idref=\"body" << workload.dof << "\"/>\n"
+        << "\t\t\t\t<b idref=\"tool\"/>\n"
+        << "\t\t\t</frame>\n";
+    writeVector(out, "rotation", 0, 0, 0, "\t\t\t");
+    writeVector(out, "translation", length, 0, 0, "\t\t\t");
+    out << "\t\t</fixed>\n"
+        << "\t</model>\n"
+        << "</rlmdl>\n";
+}
+
+static void writeShape(std::ostream& out, double x, double y, double z, const double* size, const char* color, const std::string& indent)
+{
+    out << indent << "Transform {\n"
+        << indent << "\ttranslation " << x << " " << y << " " << z << "\n"
+        << indent << "\tchildren [\n"
+        << indent << "\t\tShape {\n"
+        << indent << "\t\t\tappearance Appearance { material Material { diffuseColor " << color << " } }\n"
+        << indent << "\t\t\tgeometry Box { size " << size[0] << " " << size[1] << " " << size[2] << " }\n"
+        << indent << "\t\t}\n"
+        << indent << "\t]\n"
+        << indent << "}\n";
+}
+
+static void writeScene(const Workload& workload, const std::vector<Box>& boxes, const std::string& vrmlPath, const std::string& scenePath)
+{
+    double length = workload.reach / workload.dof;
+    
+    std::ofstream vrml(vrmlPath.c_str());
+    vrml.precision(10);
+    vrml << "#VRML V2.0 utf8\n"
+         << "DEF robot Transform {\n"
+         << "\tchildren [\n";
+    
+    for (int i = 0; i <= workload.dof; ++i)
+    {
+        vrml << "\t\tDEF body" << i << " Transform {\n"
+             << "\t\t\tchildren [\n";
+        if (0 == i)
+        {
+            double size[3] = { 0.1, 0.1, 0.1 };
+            writeShape(vrml, 0, 0, -0.1, size, "0.3 0.3 0.3", "\t\t\t\t");
+        }
+        else
+        {
+            // Shortened at both ends to leave clearance at the joints
+            double size[3] = { 0.9 * length, linkWidth, linkWidth };
+            writeShape(vrml, 0.5 * length, 0, 0, size, "1 0.5 0", "\t\t\t\t");
+        }
+        vrml << "\t\t\t]\n"
+             << "\t\t}\n";
+    }
+    
+    vrml << "\t]\n"
+         << "}\n"
+         << "DEF obstacles Transform {\n"
+         << "\tchildren [\n";
+    
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        vrml << "\t\tDEF obstacle" << i << " Transform {\n"
+             << "\t\t\ttranslation " << boxes[i].center[0] << " " << boxes[i].center[1] << " " << boxes[i].center[2] << "\n"
+             << "\t\t\tchildren [\n";
+        writeShape(vrml, 0, 0, 0, boxes[i].size, "0.5 0.5 0.8", "\t\t\t\t");
+        vrml << "\t\t\t]\n"
+             << "\t\t}\n";
+    }
+    
+    vrml << "\t]\n"
+         << "}\n";
+    
+    std::ofstream scene(scenePath.c_str());
+    scene << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+          << "<rlsg>\n"
+          << "\t<scene href=\"" << workload.name << ".wrl\">\n"
+          << "\t\t<model name=\"robot\">\n";
+    for (int i = 0; i <= workload.dof; ++i)
+    {
+        scene << "\t\t\t<body name=\"body" << i << "\"/>\n";
+    }
+    scene << "\t\t</model>\n"
+          << "\t\t<model name=\"obstacles\">\n";
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        scene << "\t\t\t<body name=\"obstacle" << i << "\"/>\n";
+    }
+    scene << "\t\t</model>\n"
+          << "\t</scene>\n"
+          << "</rlsg>\n";
+}
+
+static void writePlan(const Workload& workload, const std::string& path)
+{
+    std::ofstream out(path.c_str());
+    
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<rlplan xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" xsi:noNamespaceSchemaLocation=\"rlplan.xsd\">\n"
+        << "\t<" << workload.planner << ">\n"
+        << "\t\t<duration>" << workload.duration << "</duration>\n"
+        << "\t\t<goal>\n";
+    for (int i = 0; i < workload.dof; ++i)
+    {
+        out << "\t\t\t<q unit=\"deg\">" << (0 == i ? 180 : 0) << "</q>\n";
+    }
+    out << "\t\t</goal>\n"
+        << "\t\t<model>\n"
+        << "\t\t\t<kinematics href=\"models/" << workload.name << ".rlmdl.xml\" type=\"mdl\"/>\n"
+        << "\t\t\t<model>0</model>\n"
+        << "\t\t\t<scene href=\"models/" << workload.name << ".rlsg.xml\"/>\n"
+        << "\t\t</model>\n"
+        << "\t\t<start>\n";
+    for (int i = 0; i < workload.dof; ++i)
+    {
+        out << "\t\t\t<q unit=\"deg\">0</q>\n";
+    }
+    out << "\t\t</start>\n"
+        << "\t\t<delta unit=\"deg\">1</delta>\n"
+        << "\t\t<epsilon>0.001</epsilon>\n"
+        << "\t\t<uniformSampler/>\n"
+        << "\t</" << workload.planner << ">\n"
+        << "</rlplan>\n";
+}
+
+// Sample collision-free start/goal pairs with the generated plan loaded into the wrapper
+static int writeQueries(const Workload& workload, const std::string& planPath, const std::string& queryPath, int count)
+{
+    void* planner = CreatePlanner();
+    if (!planner || RL_SUCCESS != LoadPlanXml(planner, planPath.c_str()))
+    {
+        std::cerr << workload.name << ": Generated plan does not load, no queries written" << std::endl;
+        DestroyPlanner(planner);
+        return 0;
+    }
+    
+    const double pi = 3.14159265358979323846;
+    std::mt19937 engine(workload.seed + 1);
+    std::uniform_real_distribution<double> first(-pi, pi);
+    std::uniform_real_distribution<double> other(-150.0 * pi / 180.0, 150.0 * pi / 180.0);
+    
+    std::ofstream out(queryPath.c_str());
+    out << "# start ; goal (radians)\n";
+    out.precision(10);
+    
+    std::vector<double> q(workload.dof);
+    std::vector<std::vector<double>> valid;
+    int written = 0;
+    
+    for (int attempt = 0; written < count && attempt < 1000 * count; ++attempt)
+    {
+        for (int i = 0; i < workload.dof; ++i)
+        {
+            q[i] = (0 == i) ? first(engine) : other(engine);
+        }
+        
+        if (1 != IsValidConfiguration(planner, q.data(), workload.dof))
+        {
+            continue;
+        }
+        
+        valid.push_back(q);
+        if (valid.size() == 2)
+        {
+            for (int i = 0; i < workload.dof; ++i)
+            {
+                out << (i > 0 ? " " : "") << valid[0][i];
+            }
+            out << " ;";
+            for (int i = 0; i < workload.dof; ++i)
+            {
+                out << " " << valid[1][i];
+            }
+            out << "\n";
+            valid.clear();
+            ++written;
+        }
+    }
+    
+    DestroyPlanner(planner);
+    return written;
+}
+
+int main(int argc, char** argv)
+{
+    rlwrapper::Options options(argc, argv);
+    
+    if (!options.has("output"))
+    {
+        std::cerr << "Usage: rlwrapper_scenegen --output=<directory> [--dof=2,4,6,8,10,12] [--obstacles=0,10,50] [--passage=0]" << std::endl
+                  << "                          [--reach=1.0] [--obstacle-size=0.05,0.2] [--seed=1] [--planner=rrtConCon]" << std::endl
+                  << "                          [--duration=30] [--queries=0]" << std::endl;
+        return 1;
+    }
+    
+    std::string output = options.get("output", "");
+    std::vector<int> dofs = options.getIntList("dof", "2,4,6,8,10,12");
+    std::vector<int> obstacleCounts = options.getIntList("obstacles", "0,10,50");
+    std::vector<std::string> passages = options.getList("passage", "0");
+    std::vector<std::string> sizes = options.getList("obstacle-size", "0.05,0.2");
+    int queries = std::max(0, options.getInt("queries", 0));
+    
+    if (!makeDirectory(output) || !makeDirectory(output + "/models"))
+    {
+        std::cerr << "rlwrapper_scenegen: Cannot write to " << output << std::endl;
+        return 1;
+    }
+    
+    SetLogLevel(RL_LOG_LEVEL_WARNING);
+    
+    for (std::size_t d = 0; d < dofs.size(); ++d)
+    {
+        if (dofs[d] < 2 || dofs[d] > 12)
+        {
+            std::cerr << "rlwrapper_scenegen: Skipping DOF " << dofs[d] << " (supported: 2 to 12)" << std::endl;
+            continue;
+        }
+        
+        for (std::size_t o = 0; o < obstacleCounts.size(); ++o)
+        {
+            for (std::size_t p = 0; p < passages.size(); ++p)
+            {
+                Workload workload;
+                workload.dof = dofs[d];
+                workload.obstacles = std::max(0, obstacleCounts[o]);
+                workload.passage = std::max(0.0, std::atof(passages[p].c_str()));
+                
+                // Walls of a slit narrower than the links would collide with the start and goal poses
+                if (workload.passage > 0 && workload.passage <= 2 * linkWidth)
+                {
+                    std::cerr << "rlwrapper_scenegen: Skipping passage width " << workload.passage << " (must exceed " << 2 * linkWidth << ")" << std::endl;
+                    continue;
+                }
+                
+                workload.reach = options.getDouble("reach", 1.0);
+                workload.minSize = std::atof(sizes[0].c_str());
+                workload.maxSize = sizes.size() > 1 ? std::atof(sizes[1].c_str()) : workload.minSize;
+                workload.seed = static_cast<unsigned int>(options.getInt("seed", 1));
+                workload.planner = options.get("planner", "rrtConCon");
+                workload.duration = options.getDouble("duration", 30);
+                
+                std::ostringstream name;
+                name << "chain" << workload.dof << "_obstacles" << workload.obstacles;
+                if (workload.passage > 0)
+                {
+                    name << "_passage" << workload.passage;
+                }
+                name << "_seed" << workload.seed;
+                workload.name = name.str();
+                
+                std::vector<Box> boxes = generateObstacles(workload);
+                std::string planPath = output + "/" + workload.name + ".xml";
+                
+                writeKinematics(workload, output + "/models/" + workload.name + ".rlmdl.xml");
+                writeScene(workload, boxes, output + "/models/" + workload.name + ".wrl", output + "/models/" + workload.name + ".rlsg.xml");
+                writePlan(workload, planPath);
+                
+                std::cerr << planPath;
+                if (queries > 0)
+                {
+                    int written = writeQueries(workload, planPath, output + "/" + workload.name + ".queries", queries);
+                    std::cerr << " (" << written << " queries)";
+                }
+                std::cerr << std::endl;
+            }
+        }
+    }
+    
+    FlushLog();
+    
+    return 0;
+}